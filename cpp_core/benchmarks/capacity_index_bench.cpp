@@ -0,0 +1,59 @@
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include "capacity_index.hpp"
+
+// Times "first hall with capacity >= n" with CapacityIndex against std::lower_bound over the same
+// sorted capacities. Run as: capacity_index_bench [queries]
+namespace {
+
+template <typename Lookup>
+double ns_per_query(const std::vector<int> &queries, Lookup lookup){
+    long long checksum = 0;
+    auto started = std::chrono::steady_clock::now();
+    for(auto seats: queries)checksum += lookup(seats);
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    // Printed so the lookups cannot be optimised away.
+    std::fprintf(stderr, "checksum %lld\n", checksum);
+    return elapsed / queries.size();
+}
+
+void run(const char *label, std::vector<int> capacities, int query_count, std::mt19937 &rng){
+    std::sort(capacities.begin(), capacities.end());
+    CapacityIndex index(capacities.begin(), capacities.end());
+
+    std::uniform_int_distribution<int> seats(0, capacities.back() + 10);
+    std::vector<int> queries(query_count);
+    for(auto &query: queries)query = seats(rng);
+
+    double bucketed = ns_per_query(queries, [&index](int n){ return index.lower_bound_rank(n); });
+    double binary = ns_per_query(queries, [&capacities](int n){
+        return (int)(std::lower_bound(capacities.begin(), capacities.end(), n) - capacities.begin());
+    });
+    std::printf("%-28s %6zu halls: std::lower_bound %6.1f ns, bucketed %6.1f ns\n", label, capacities.size(), binary, bucketed);
+}
+
+}
+
+int main(int argc, char **argv){
+    int query_count = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+    std::mt19937 rng(12345);
+
+    std::uniform_int_distribution<int> capacity(20, 1020);
+    for(int halls: {64, 1000, 20000}){
+        std::vector<int> capacities(halls);
+        for(auto &seats: capacities)seats = capacity(rng);
+        run("random capacities 20-1020", capacities, query_count, rng);
+    }
+
+    // Every hall in one bucket: the scan inside the bucket is linear in the hall count.
+    for(int halls: {64, 1000}){
+        std::vector<int> capacities(halls);
+        for(auto &seats: capacities)seats = 40 + (int)(rng() % 10);
+        run("capacities 40-49", capacities, query_count, rng);
+    }
+    return 0;
+}
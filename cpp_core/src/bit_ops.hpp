@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Number of set bits in a 64-bit word.
+ */
+inline int popcount64(uint64_t word){
+#if defined(_MSC_VER)
+    return (int)__popcnt64(word);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit of a non-zero 64-bit word.
+ */
+inline int ctz64(uint64_t word){
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * @brief Index of the highest set bit of a non-zero 64-bit word.
+ */
+inline int msb64(uint64_t word){
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
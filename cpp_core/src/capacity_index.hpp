@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @class CapacityIndex
+ * @brief Immutable capacity lookup over one building's halls, ranked by ascending capacity.
+ * Besides the sorted capacities it stores, for every bucket of BUCKET_SEATS seats, the first
+ * rank whose capacity reaches the bucket, so "first hall with capacity >= n" is one bucket
+ * jump followed by a scan over halls of that bucket only. The scan is linear in the halls of the
+ * bucket, so when many halls fall into one bucket (many rooms of the same size) a lookup costs
+ * more than a binary search; benchmarks/capacity_index_bench.cpp measures both cases.
+ */
+class CapacityIndex {
+public:
+    static constexpr int BUCKET_SEATS = 10;
+
+    CapacityIndex() = default;
+
+    /**
+     * @brief Builds the index over capacities [first, last), which must already be sorted.
+     * @throws std::invalid_argument if the capacities are not in ascending order.
+     */
+    template <typename It>
+    CapacityIndex(It first, It last) : capacities(first, last) {
+        if(!std::is_sorted(capacities.begin(), capacities.end())){
+            throw std::invalid_argument("CapacityIndex: hall capacities are not sorted");
+        }
+
+        int largest = capacities.empty() ? 0 : std::max(capacities.back(), 0);
+        bucket_first.assign(largest / BUCKET_SEATS + 2, 0);
+        int rank = 0;
+        for(int bucket = 0; bucket < (int)bucket_first.size(); bucket++){
+            while(rank < size() && capacities[rank] < bucket * BUCKET_SEATS)rank++;
+            bucket_first[bucket] = rank;
+        }
+    }
+
+    int size() const { return (int)capacities.size(); }
+
+    int capacity_at(int rank) const { return capacities[rank]; }
+
+    // First rank whose hall has capacity >= seats, or size() when none does.
+    int lower_bound_rank(int seats) const {
+        if(seats <= 0)return 0;
+        int bucket = seats / BUCKET_SEATS;
+        if(bucket >= (int)bucket_first.size())return size();
+
+        int rank = bucket_first[bucket];
+        while(rank < size() && capacities[rank] < seats)rank++;
+        return rank;
+    }
+
+private:
+    std::vector<int> capacities;   // by rank, ascending
+    std::vector<int> bucket_first; // first rank with capacity >= bucket * BUCKET_SEATS
+};
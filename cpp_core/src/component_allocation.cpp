@@ -0,0 +1,114 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "component_allocation.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+// Lectures per batch of components solved on one copy of the venue table.
+constexpr int BATCH_LECTURES = 64;
+
+// Union-find with path halving and union by size.
+struct DisjointSets {
+    std::vector<int> parent;
+    std::vector<int> size;
+
+    explicit DisjointSets(int count) : parent(count), size(count, 1) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    int find(int item){
+        while(parent[item] != item){
+            parent[item] = parent[parent[item]];
+            item = parent[item];
+        }
+        return item;
+    }
+
+    void unite(int a, int b){
+        a = find(a);
+        b = find(b);
+        if(a == b)return;
+        if(size[a] < size[b])std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+    }
+};
+
+}
+
+std::vector<std::vector<int>> lecture_components(const std::vector<Lecture> &lectures, const SchedulePatternTable &schedule_patterns){
+    int lecture_count = lectures.size();
+    DisjointSets sets(lecture_count);
+
+    // Every lecture is joined to the first lecture seen in each of its slots.
+    std::vector<int> slot_owner(TERM_SLOTS, -1);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        schedule_patterns.slots(lectures[lecture].lecture_pattern).for_each_slot([&](int slot){
+            if(slot_owner[slot] == -1)slot_owner[slot] = lecture;
+            else sets.unite(slot_owner[slot], lecture);
+        });
+    }
+
+    std::vector<std::vector<int>> components;
+    std::vector<int> component_of(lecture_count, -1);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        int root = sets.find(lecture);
+        if(component_of[root] == -1){
+            component_of[root] = components.size();
+            components.emplace_back();
+        }
+        components[component_of[root]].push_back(lecture);
+    }
+    return components;
+}
+
+ComponentAllocationResult component_allocation(std::vector<Lecture> &lectures, VenueTable &venues, const SchedulePatternTable &schedule_patterns, const ComponentSolver &solver, int threads){
+    std::vector<std::vector<int>> components = lecture_components(lectures, schedule_patterns);
+
+    ComponentAllocationResult result;
+    result.components = components.size();
+    std::vector<std::vector<Lecture>> solved(components.size());
+    for(int component = 0; component < (int)components.size(); component++){
+        result.largest_component = std::max(result.largest_component, (int)components[component].size());
+        for(auto lecture: components[component])solved[component].push_back(lectures[lecture]);
+    }
+
+    // Components share no slot, so several of them can be solved one after the other on one copy of
+    // the venue table without seeing each other's bookings. Batches are cut in component order once
+    // they hold BATCH_LECTURES lectures, so they depend on the input only, not on the thread count.
+    std::vector<std::vector<int>> batches;
+    int batch_lectures = 0;
+    for(int component = 0; component < (int)components.size(); component++){
+        if(batches.empty() || batch_lectures >= BATCH_LECTURES){
+            batches.emplace_back();
+            batch_lectures = 0;
+        }
+        batches.back().push_back(component);
+        batch_lectures += components[component].size();
+    }
+
+    {
+        ThreadPool pool(std::min(threads > 0 ? threads : ThreadPool::default_threads(), std::max(1, (int)batches.size())));
+        for(auto &batch: batches){
+            pool.submit([&]{
+                VenueTable local_venues = venues;
+                for(auto component: batch)solver(solved[component], local_venues);
+            });
+        }
+        pool.wait();
+    }
+
+    // Results go back to each lecture's own position, so the vector keeps the caller's order.
+    for(int component = 0; component < (int)components.size(); component++){
+        for(int ind = 0; ind < (int)components[component].size(); ind++){
+            Lecture &lecture = lectures[components[component][ind]];
+            lecture.assignment = solved[component][ind].assignment;
+            if(lecture.assignment != -1){
+                venues.book(lecture.assignment, lecture.course_code, lecture.section, schedule_patterns.slots(lecture.lecture_pattern));
+            }
+        }
+    }
+    return result;
+}
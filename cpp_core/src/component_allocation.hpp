@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+
+/**
+ * @brief Splits lectures into groups that share no slot, directly or through other lectures.
+ * Lectures of different groups never compete for a hall, so each group can be allocated on its own.
+ * @return Lecture indices per group, groups ordered by their first lecture index.
+ */
+std::vector<std::vector<int>> lecture_components(const std::vector<Lecture> &lectures, const SchedulePatternTable &schedule_patterns);
+
+// Allocates one component: assigns and books halls in the given copy of the venue table (which may
+// already hold bookings of other components, always in other slots).
+using ComponentSolver = std::function<void(std::vector<Lecture> &lectures, VenueTable &venues)>;
+
+struct ComponentAllocationResult {
+    int components = 0;
+    int largest_component = 0; // lectures in the largest component
+};
+
+/**
+ * @brief Runs a solver on every component in parallel and merges the results.
+ * Each component is solved on its own lectures; components are batched by input order, and every
+ * batch gets one copy of the venue table, so the outcome does not depend on the thread count or
+ * scheduling. Each lecture's result is written back in place, so the vector keeps its order, and
+ * its hall is booked in the shared venue table.
+ * @param threads Worker threads; ThreadPool::default_threads() when <= 0.
+ */
+ComponentAllocationResult component_allocation(std::vector<Lecture> &lectures, VenueTable &venues, const SchedulePatternTable &schedule_patterns, const ComponentSolver &solver, int threads);
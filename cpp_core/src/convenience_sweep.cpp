@@ -0,0 +1,52 @@
+#include <vector>
+#include <algorithm>
+#include "convenience_sweep.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+// True when a is at least as good as b everywhere and strictly better somewhere.
+bool dominates(const SweepPoint &a, const SweepPoint &b){
+    bool no_worse = a.stats.unassigned <= b.stats.unassigned && a.stats.wasted_seats <= b.stats.wasted_seats && a.priority_hit_rate >= b.priority_hit_rate;
+    bool better = a.stats.unassigned < b.stats.unassigned || a.stats.wasted_seats < b.stats.wasted_seats || a.priority_hit_rate > b.priority_hit_rate;
+    return no_worse && better;
+}
+
+}
+
+std::vector<SweepPoint> convenience_factor_sweep(const std::vector<Lecture> &lectures, const VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const std::vector<int> &factors, const SchedulePatternTable &schedule_patterns, int threads){
+    std::vector<SweepPoint> points(factors.size());
+    std::vector<int> buildings = venues.resolve_buildings(lecture_building_priority_order);
+    int first_building = buildings.empty() ? -1 : buildings[0];
+
+    {
+        ThreadPool pool(std::min(threads > 0 ? threads : ThreadPool::default_threads(), std::max(1, (int)factors.size())));
+        for(int ind = 0; ind < (int)factors.size(); ind++){
+            pool.submit([&, ind]{
+                std::vector<Lecture> local_lectures = lectures;
+                VenueTable local_venues = venues;
+                core_lecture_allocation_logic(local_lectures, local_venues, lecture_building_priority_order, factors[ind], schedule_patterns);
+
+                SweepPoint &point = points[ind];
+                point.convenience_factor = factors[ind];
+                point.stats = allocation_stats(local_lectures, local_venues);
+                int assigned = 0;
+                int hits = 0;
+                for(auto &lecture: local_lectures){
+                    if(lecture.assignment == -1)continue;
+                    assigned++;
+                    if((int)local_venues.building_ids[lecture.assignment] == first_building)hits++;
+                }
+                point.priority_hit_rate = assigned ? (double)hits / assigned : 0;
+            });
+        }
+        pool.wait();
+    }
+
+    for(auto &point: points){
+        point.pareto = std::none_of(points.begin(), points.end(), [&point](const SweepPoint &other){
+            return dominates(other, point);
+        });
+    }
+    return points;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+#include "lecture_allocation.hpp"
+
+struct SweepPoint {
+    int convenience_factor = 0;
+    AllocationStats stats;
+    double priority_hit_rate = 0; // share of assigned lectures placed in the first priority building
+    bool pareto = false;          // no other factor is at least as good on all three and better on one
+};
+
+/**
+ * @brief Runs the greedy lecture allocation once per convenience factor, concurrently.
+ * The lectures and venue table are only read; every factor works on its own copy, so results do not
+ * depend on the thread count. Points come back in the order of `factors`, with the Pareto-optimal
+ * ones (fewer unassigned, fewer wasted seats, higher priority hit rate) flagged.
+ * @param threads Worker threads; ThreadPool::default_threads() when <= 0.
+ */
+std::vector<SweepPoint> convenience_factor_sweep(const std::vector<Lecture> &lectures, const VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const std::vector<int> &factors, const SchedulePatternTable &schedule_patterns, int threads);
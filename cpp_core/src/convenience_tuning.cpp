@@ -0,0 +1,101 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "convenience_tuning.hpp"
+#include "free_hall_index.hpp"
+#include "sort_order.hpp"
+
+namespace {
+
+// Factors tried one by one above the bisection result.
+constexpr int TUNING_CLIMB = 2;
+
+int required_seats(const Lecture &lecture, int convenience_factor){
+    return (lecture.students_registered * (convenience_factor + 100))/100;
+}
+
+/**
+ * Moves the lectures whose hall gives less than the factor's headroom into halls that do.
+ * @return false, leaving lectures and venues half updated, when one of them finds no such hall.
+ */
+bool probe(std::vector<Lecture> &lectures, VenueTable &venues, const std::vector<int> &buildings, const std::vector<int> &by_size, int convenience_factor, const SchedulePatternTable &schedule_patterns, long long &moved){
+    std::vector<int> pending;
+    for(auto lecture: by_size){
+        Lecture &current = lectures[lecture];
+        if(current.assignment != -1 && venues.capacities[current.assignment] >= required_seats(current, convenience_factor))continue;
+        if(current.assignment != -1){
+            venues.unbook(current.assignment, current.course_code, current.section, schedule_patterns.slots(current.lecture_pattern));
+            current.unassignLectureHall();
+        }
+        pending.push_back(lecture);
+    }
+    moved += pending.size();
+    if(pending.empty())return true;
+
+    std::vector<FreeHallIndex> free_halls(venues.building_count());
+    for(auto building: buildings)free_halls[building] = FreeHallIndex(venues, building);
+
+    for(auto lecture: pending){
+        Lecture &current = lectures[lecture];
+        const SlotMask &slots = schedule_patterns.slots(current.lecture_pattern);
+        bool placed = false;
+        for(auto building: buildings){
+            FreeHallIndex &halls = free_halls[building];
+            int rank = halls.first_free(slots, halls.lower_bound_rank(required_seats(current, convenience_factor)), halls.size());
+            if(rank == -1)continue;
+
+            current.assignLectureHall(halls.venue_at(rank));
+            venues.book(current.assignment, current.course_code, current.section, slots);
+            halls.occupy(rank, slots);
+            placed = true;
+            break;
+        }
+        if(!placed)return false;
+    }
+    return true;
+}
+
+}
+
+ConvenienceTuningResult tune_convenience_factor(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int from, int to, const SchedulePatternTable &schedule_patterns){
+    ConvenienceTuningResult result;
+    std::vector<int> buildings = venues.resolve_buildings(lecture_building_priority_order);
+
+    std::vector<int> by_size = counting_sort_order(lectures.size(), [&lectures](int ind){ return lectures[ind].students_registered; });
+
+    // The lowest factor is solved from the given state; every later probe warm-starts from the best one.
+    std::vector<Lecture> best_lectures = lectures;
+    VenueTable best_venues = venues;
+    result.probes++;
+    if(!probe(best_lectures, best_venues, buildings, by_size, from, schedule_patterns, result.lectures_moved))return result;
+
+    // Probes the factor from the best assignment so far and keeps the result when it succeeds.
+    auto try_factor = [&](int factor){
+        std::vector<Lecture> trial_lectures = best_lectures;
+        VenueTable trial_venues = best_venues;
+        result.probes++;
+        if(!probe(trial_lectures, trial_venues, buildings, by_size, factor, schedule_patterns, result.lectures_moved))return false;
+        best_lectures.swap(trial_lectures);
+        best_venues = std::move(trial_venues);
+        return true;
+    };
+
+    int low = from;
+    int high = to;
+    while(low < high){
+        int mid = low + (high - low + 1) / 2;
+        if(try_factor(mid))low = mid;
+        else high = mid - 1;
+    }
+
+    // A failed probe above low may only mean first-fit was unlucky from that start; up to
+    // TUNING_CLIMB neighbours are retried from the assignment of low, so the whole search stays
+    // within O(log(to - from)) probes.
+    for(int step = 0; step < TUNING_CLIMB && low < to && try_factor(low + 1); step++)low++;
+
+    result.feasible = true;
+    result.convenience_factor = low;
+    lectures.swap(best_lectures);
+    venues = std::move(best_venues);
+    return result;
+}
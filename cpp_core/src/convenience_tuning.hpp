@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+
+struct ConvenienceTuningResult {
+    bool feasible = false;     // every lecture fits with at least the `from` headroom
+    int convenience_factor = 0; // largest headroom found, valid when feasible
+    int probes = 0;
+    long long lectures_moved = 0; // lectures re-placed over all probes
+};
+
+/**
+ * @brief Looks for the largest convenience factor in [from, to] at which every lecture gets a hall
+ * with capacity >= students * (100 + factor) / 100, treating the headroom as a hard limit.
+ * A probe places lectures first-fit, so it can fail at a factor that some other assignment would
+ * meet, and success need not be monotone in the factor. The factor is bisected, then raised one
+ * step at a time, at most twice, while the next probe still succeeds; the result is the largest factor found, not
+ * necessarily the largest one feasible.
+ * Every probe starts from the last feasible assignment: lectures whose hall still gives the probed
+ * headroom keep it, and only the others are released and placed again, smallest first, in the first
+ * free hall of the priority buildings that gives the headroom. On success the lectures and venues
+ * hold the assignment of the returned factor; otherwise they are left as they were.
+ */
+ConvenienceTuningResult tune_convenience_factor(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int from, int to, const SchedulePatternTable &schedule_patterns);
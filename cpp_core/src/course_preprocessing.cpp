@@ -1,133 +1,79 @@
-#pragma once
-
 #include <vector>
 #include <string>
+#include <stdexcept>
 #include "ds.hpp"
-#include "helper.hpp"
-#include <map>
-
-std::vector<Course> course_preprocessing_function(std::vector<nlohmann::json> &course_list){
-    
-    int course_size = course_list.size();
-    std::vector<Course> lecture_tutorial_lists;
-    std::map <std::string, int> modular_first_index;
-
-    std::vector<nlohmann::json> modular_second_part;
-
-    for(int ind = 0; ind < course_size; ind++){
-        std::string course_code;
-        std::string course_name;
-        std::vector<int> lecture_schedule;
-        std::vector<int> tutorial_schedule;
-        int students_registered;
-        int tutorial_count;
-        bool is_modular;
-
-        if(course_list[ind].contains("Modular Course") && std::stoi(course_list[ind].at("Modular Course").get<std::string>()) == 2){
-            modular_second_part.push_back(course_list[ind]); 
-            continue;
-        } 
-
-        if(course_list[ind].contains("Course Name")){
-            course_name = course_list[ind].at("Course Name");
-        }
-
-        if(course_list[ind].contains("Course Code")){
-            course_code = course_list[ind].at("Course Code");
-        }
-
-        if(course_list[ind].contains("Section")){
-            course_code = course_code + "_" + course_list[ind].at("Section").get<std::string>();
-        }
+#include "schedule_pattern.hpp"
 
-        if(course_list[ind].contains("Lecture Schedule")){
-            lecture_schedule = timeString_to_timeINT(course_list[ind].at("Lecture Schedule"));
-            sort(lecture_schedule.begin(), lecture_schedule.end());
-        }
+namespace {
 
-        if(course_list[ind].contains("Tutorial Schedule")){
-            tutorial_schedule = timeString_to_timeINT(course_list[ind].at("Tutorial Schedule"));
-            sort(tutorial_schedule.begin(), tutorial_schedule.end());
+// Integer field given either as a number or as a numeric string, `fallback` when absent or not numeric.
+int course_int(const nlohmann::json &course, const char *key, int fallback){
+    if(!course.contains(key))return fallback;
+    const nlohmann::json &value = course.at(key);
+    if(value.is_number_integer())return value.get<int>();
+    if(value.is_string()){
+        try{
+            return std::stoi(value.get_ref<const std::string&>());
         }
-
-        if(course_list[ind].contains("Students Registered")){
-            students_registered = std::stoi(course_list[ind].at("Students Registered").get<std::string>());
-        } else {
-            students_registered = 0;
+        catch(const std::exception &){
+            return fallback;
         }
+    }
+    return fallback;
+}
 
-        if(course_list[ind].contains("Tutorial Count")){
-            tutorial_count = std::stoi(course_list[ind].at("Tutorial Count").get<std::string>());
-
-        } else {
-            tutorial_count = 0;
-        }
-        
-        if(course_list[ind].contains("Modular Course") && std::stoi(course_list[ind].at("Modular Course").get<std::string>()) == 1){
-            modular_first_index[course_code] = lecture_tutorial_lists.size() - 1;
-            is_modular = true;
-        }
+}
 
-        Course course = Course(course_code, course_name, lecture_schedule, tutorial_schedule, tutorial_count, students_registered, is_modular);
-        lecture_tutorial_lists.push_back(course);
+// "Modular Course" 1 and 2 are the first and second half of the term; anything else runs all term.
+TermPart course_term_part(const nlohmann::json &course){
+    switch(course_int(course, "Modular Course", 0)){
+        case 1: return TermPart::FirstHalf;
+        case 2: return TermPart::SecondHalf;
+        default: return TermPart::Full;
     }
+}
 
-    for(int ind = 0; ind < modular_second_part.size(); ind++){
-        std::string course_code;
-        std::string course_name;
-        std::vector<int> lecture_schedule;
-        std::vector<int> tutorial_schedule;
-        int students_registered;
-        int tutorial_count;
-        bool is_modular;
+std::vector<Course> course_preprocessing_function(const std::vector<nlohmann::json> &course_list, SchedulePatternTable &schedule_patterns, NamePools &names){
 
-        if(course_list[ind].contains("Course Name")){
-            course_name = course_list[ind].at("Course Name");
-        }
+    std::vector<Course> lecture_tutorial_lists;
+    lecture_tutorial_lists.reserve(course_list.size());
 
-        if(course_list[ind].contains("Course Code")){
-            course_code = course_list[ind].at("Course Code");
-        }
+    // Each half of a modular course is a course of its own; its schedules are interned for the
+    // weeks it runs in, so the two halves can share a hall and slot.
+    for(auto &entry: course_list){
+        uint32_t course_code = names.course_codes.intern("");
+        uint32_t section = 0;
+        uint32_t course_name = 0;
+        int lecture_pattern = SchedulePatternTable::EMPTY_PATTERN;
+        int tutorial_pattern = SchedulePatternTable::EMPTY_PATTERN;
+        TermPart part = course_term_part(entry);
 
-        if(course_list[ind].contains("Section")){
-            course_code = course_code + "_" + course_list[ind].at("Section").get<std::string>();
+        if(entry.contains("Course Name")){
+            course_name = names.course_names.intern(entry.at("Course Name").get_ref<const std::string&>());
         }
 
-        if(course_list[ind].contains("Lecture Schedule")){
-            lecture_schedule = timeString_to_timeINT(course_list[ind].at("Lecture Schedule"));
-            sort(lecture_schedule.begin(), lecture_schedule.end());
+        if(entry.contains("Course Code")){
+            course_code = names.course_codes.intern(entry.at("Course Code").get_ref<const std::string&>());
         }
 
-        if(course_list[ind].contains("Tutorial Schedule")){
-            tutorial_schedule = timeString_to_timeINT(course_list[ind].at("Tutorial Schedule"));
-            sort(tutorial_schedule.begin(), tutorial_schedule.end());
+        if(entry.contains("Section")){
+            section = names.sections.intern(entry.at("Section").get_ref<const std::string&>());
         }
 
-        if(course_list[ind].contains("Students Registered")){
-            students_registered = std::stoi(course_list[ind].at("Students Registered").get<std::string>());
-        } else {
-            students_registered = 0;
+        if(entry.contains("Lecture Schedule")){
+            lecture_pattern = schedule_patterns.intern(entry.at("Lecture Schedule").get_ref<const std::string&>(), part);
         }
 
-        if(course_list[ind].contains("Tutorial Count")){
-            tutorial_count = std::stoi(course_list[ind].at("Tutorial Count").get<std::string>());
-        } else {
-            tutorial_count = 0;
+        if(entry.contains("Tutorial Schedule")){
+            tutorial_pattern = schedule_patterns.intern(entry.at("Tutorial Schedule").get_ref<const std::string&>(), part);
         }
 
-        is_modular = true;
+        int students_registered = course_int(entry, "Students Registered", 0);
+        int tutorial_count = course_int(entry, "Tutorial Count", 0);
 
-        if(course_list[ind].contains("Modular Course")){
-            int index = modular_first_index[course_list[ind].at("Modular Course")];
-            lecture_tutorial_lists[index].Append_course_code("#" + course_code);
-            lecture_tutorial_lists[index].Append_course_name("#" + course_name);
-            lecture_tutorial_lists[index].Update_max_registered_students(students_registered);
-            lecture_tutorial_lists[index].Update_max_tutorial_count(tutorial_count);
-        } else {
-            Course course = Course(course_code, course_name, lecture_schedule, tutorial_schedule, tutorial_count, students_registered, is_modular);
-            lecture_tutorial_lists.push_back(course);
-        }
+        Course course = Course(course_code, section, course_name, lecture_pattern, tutorial_pattern, tutorial_count, students_registered, part);
+        lecture_tutorial_lists.push_back(course);
     }
 
     return lecture_tutorial_lists;
-}
\ No newline at end of file
+}
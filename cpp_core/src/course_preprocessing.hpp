@@ -3,5 +3,9 @@
 #include <vector>
 #include <string>
 #include "ds.hpp"
+#include "schedule_pattern.hpp"
 
-std::vector<Course> course_preprocessing_function(std::vector<nlohmann::json> &course_list);
\ No newline at end of file
+/** @brief Part of the term a course or output line runs in, from its "Modular Course" field. */
+TermPart course_term_part(const nlohmann::json &course);
+
+std::vector<Course> course_preprocessing_function(const std::vector<nlohmann::json> &course_list, SchedulePatternTable &schedule_patterns, NamePools &names);
\ No newline at end of file
@@ -6,13 +6,14 @@ std::pair<std::vector<Lecture>, std::vector<Tutorial>> course_processing(std::ve
 
     std::vector<Lecture>  lectures;
     std::vector<Tutorial> tutorials;   
+    lectures.reserve(preprocessed_course_list.size());
     
-    for(auto course: preprocessed_course_list){
-        Lecture lec = Lecture(course.course_name, course.course_code, course.lecture_schedule, course.students_registered, course.is_modular);
+    for(auto &course: preprocessed_course_list){
+        Lecture lec = Lecture(course.course_name, course.course_code, course.section, course.lecture_pattern, course.students_registered, course.term_part);
         lectures.push_back(lec);
 
         if(course.tutorial_count > 0){
-            Tutorial tut = Tutorial(course.course_name, course.course_code, course.tutorial_schedule, course.students_registered, course.tutorial_count, course.is_modular);
+            Tutorial tut = Tutorial(course.course_name, course.course_code, course.section, course.tutorial_pattern, course.students_registered, course.tutorial_count, course.term_part);
             tutorials.push_back(tut);
         }
     }
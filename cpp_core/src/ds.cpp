@@ -1,13 +1,12 @@
-#pragma once
-
 #include "ds.hpp"
+#include "helper.hpp"
 #include <stdexcept>
 #include <algorithm>
 
 // Venue constructor implementation
-Venue::Venue(const nlohmann::json& j) : capacity(0) {
+Venue::Venue(const nlohmann::json& j, NamePools &names) : hall_name(names.halls.intern("")), capacity(0), building(StringPool::NO_ID) {
     if (j.contains("name") && j.at("name").is_string()) {
-        this->hall_name = j.at("name").get<std::string>();
+        this->hall_name = names.halls.intern(j.at("name").get_ref<const std::string&>());
     }
 
     if (j.contains("capacity") && j.at("capacity").is_number()) {
@@ -15,78 +14,38 @@ Venue::Venue(const nlohmann::json& j) : capacity(0) {
     }
 
     if(j.contains("building") && j.at("building").is_string()){
-        this->building = j.at("building").get<std::string>();
+        this->building = names.buildings.intern(j.at("building").get_ref<const std::string&>());
     }
 
     if (j.contains("schedule")) {
         // Function to write the operational time
-        Operational_Time_Marker(j.at("schedule"), "monday", 1);
-        Operational_Time_Marker(j.at("schedule"), "tuesday", 2);
-        Operational_Time_Marker(j.at("schedule"), "wednesday", 3);
-        Operational_Time_Marker(j.at("schedule"), "thursday", 4);
-        Operational_Time_Marker(j.at("schedule"), "friday", 5);
+        for (int day_index = 0; day_index < DAYS_PER_WEEK; day_index++) {
+            Operational_Time_Marker(j.at("schedule"), WEEK_DAYS[day_index].name, day_index);
+        }
+        // Opening hours are weekly and hold in both halves of the term.
+        this->is_available = in_term(this->is_available, TermPart::Full);
     }
 }
 
 // Venue::Operational_Time_Marker implementation
-void Venue::Operational_Time_Marker(const nlohmann::json& j, std::string day, int prefix_number) {
+void Venue::Operational_Time_Marker(const nlohmann::json& j, const char *day, int day_index) {
     if (j.contains(day) && j.at(day).is_array()) {
         for (const auto& interval : j.at(day)) {
             if (interval.contains("open") && interval.at("open").is_string() &&
                 interval.contains("close") && interval.at("close").is_string()) {
                 
-                std::string open_str = interval.at("open").get<std::string>();
-                std::string close_str = interval.at("close").get<std::string>();
-
-                if (open_str.length() != 5 || close_str.length() != 5 || open_str[2] != ':' || close_str[2] != ':') {
+                int open_minute = 0, close_minute = 0;
+                if (!parse_fixed_clock(interval.at("open").get_ref<const std::string&>(), open_minute) ||
+                    !parse_fixed_clock(interval.at("close").get_ref<const std::string&>(), close_minute)) {
                     // Skip malformed time strings
                     continue;
                 }
 
-                try {
-                    int start_hour = std::stoi(open_str.substr(0, 2));
-                    int start_min = std::stoi(open_str.substr(3, 2));
-
-                    int end_hour = std::stoi(close_str.substr(0, 2));
-                    int end_min = std::stoi(close_str.substr(3, 2));
-                    
-                    // The loop will mark slots up to, but not including, the end time.
-                    // Example: 09:00 to 10:00 marks all slots from 09:00 to 09:59.
-                    int curr_hour = start_hour;
-                    int curr_min = start_min;
-
-                    while ((curr_hour * 100 + curr_min) < (end_hour * 100 + end_min)) {
-                        this->is_available[prefix_number * 10000 + (curr_hour * 100 + curr_min)] = 1;
-                        
-                        // Increment time by 30 minute
-                        curr_min+=30;
-                        if (curr_min == 60) {
-                            curr_min = 0;
-                            curr_hour++;
-                        }
-                    }
-                } catch (const std::invalid_argument& e) {
-                    // Handle cases where stoi fails (e.g., non-numeric characters)
-                    // For now, we just skip this interval
-                    continue;
-                }
+                // Slots up to, but not including, the closing time, and only those lying entirely
+                // inside the window: a 08:15 opening starts at the 08:30 slot on a half-hour grid.
+                int day_base = day_index * SLOTS_PER_DAY;
+                this->is_available.set_range(day_base + TimeGrid::slot_ceil(open_minute), day_base + close_minute / SLOT_MINUTES);
             }
         }
     }
-}
-
-void Course::Append_course_code(const std::string new_code){
-    course_code = course_code + new_code;
-}
-
-void Course::Append_course_name(const std::string new_name){
-    course_name = course_name + new_name;
-}
-
-void Course::Update_max_registered_students(const int new_students_registered){
-    students_registered = std::max(students_registered, new_students_registered);
-}
-
-void Course::Update_max_tutorial_count(const int new_toturial_count){
-    tutorial_count = std::max(tutorial_count, new_toturial_count);
 }
\ No newline at end of file
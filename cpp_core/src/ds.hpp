@@ -2,8 +2,9 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include "../helpers/json.hpp"
+#include "slot_mask.hpp"
+#include "string_pool.hpp"
 
 /**
  * @class Lecture
@@ -11,27 +12,31 @@
  */
 class Lecture {
 public:
-    std::string course_code;
-    std::string course_name;
-    std::vector<int> lecture_schedule;
+    uint32_t course_code; // IDs in NamePools
+    uint32_t section;
+    uint32_t course_name;
+    int lecture_pattern; // ID in the SchedulePatternTable
     int students_registered;
-    std::string assignment;
-    bool is_modular;
+    int assignment = -1; // venue ID, -1 while unassigned
+    TermPart term_part;  // weeks of the term the course runs in
 
-    Lecture(const std::string Course_Name, const std::string Course_Code, const std::vector<int> Lecture_Schedule, const int Students_Registered, const bool Is_Modular)
-        : course_name(Course_Name),
-            course_code(Course_Code),
-            lecture_schedule(Lecture_Schedule),
+    Lecture(const uint32_t Course_Name, const uint32_t Course_Code, const uint32_t Section, const int Lecture_Pattern, const int Students_Registered, const TermPart Term_Part)
+        : course_code(Course_Code),
+            section(Section),
+            course_name(Course_Name),
+            lecture_pattern(Lecture_Pattern),
             students_registered(Students_Registered),
-            is_modular(Is_Modular)
+            term_part(Term_Part)
     {}
 
-    static bool compareByStudents(const Lecture& a, const Lecture& b) {
-        return a.students_registered < b.students_registered; // ascending
+    bool is_modular() const { return term_part != TermPart::Full; }
+
+    void assignLectureHall(int venue){
+        assignment = venue;
     }
 
-    void assignLectureHall(std::string &lecture_hall){
-        assignment = lecture_hall;
+    void unassignLectureHall(){
+        assignment = -1;
     }
 };
 
@@ -41,89 +46,77 @@ public:
  */
 class Tutorial {
 public:
-    std::string course_code;
-    std::string course_name;
-    std::vector<int> tutoial_schedule;
+    uint32_t course_code; // IDs in NamePools
+    uint32_t section;
+    uint32_t course_name;
+    int tutorial_pattern; // ID in the SchedulePatternTable
     int students_registered;
     int tutorial_count;
-    std::vector<std::string> assignment;
-    bool is_modular;
+    std::vector<int> assignment; // venue IDs
+    TermPart term_part;
 
-    Tutorial(const std::string Course_Name, const std::string Course_Code, const std::vector<int> Tutorial_Schedule, const int Students_Registered, const int Tutorial_Count, const bool Is_Modular)
-        : course_name(Course_Name),
-            course_code(Course_Code),
-            tutoial_schedule(Tutorial_Schedule),
+    Tutorial(const uint32_t Course_Name, const uint32_t Course_Code, const uint32_t Section, const int Tutorial_Pattern, const int Students_Registered, const int Tutorial_Count, const TermPart Term_Part)
+        : course_code(Course_Code),
+            section(Section),
+            course_name(Course_Name),
+            tutorial_pattern(Tutorial_Pattern),
             students_registered(Students_Registered),
             tutorial_count(Tutorial_Count),
-            is_modular(Is_Modular)
+            term_part(Term_Part)
     {}
+
+    bool is_modular() const { return term_part != TermPart::Full; }
 };
 
 /**
  * @class Venue
  * @brief Represents a physical location (hall) where classes can be held.
- * Manages the venue's capacity and availability schedule.
+ * Holds one hall as read from the input; allocation works on the VenueTable built from these.
  */
 class Venue {
 public:
-    std::string hall_name;
+    uint32_t hall_name; // IDs in NamePools
     int capacity;
-    std::unordered_map<int, std::string> assignment;
-    std::unordered_map<int, int> is_available;
-    std::string building;
+    SlotMask is_available;
+    uint32_t building;
 
     /**
      * @brief Constructs a Venue object from a JSON object.
      * @param j The nlohmann::json object containing venue data.
+     * @param names Pools the hall and building names are interned into.
      */
-    Venue(const nlohmann::json& j);
+    Venue(const nlohmann::json& j, NamePools &names);
 
 private:
     /**
      * @brief Parses the operational time for a given day from a JSON object and marks the venue as available.
      * @param j The nlohmann::json object for the schedule.
      * @param day The string representation of the day (e.g., "monday").
-     * @param prefix_number A numerical prefix representing the day of the week.
+     * @param day_index Position of the day in WEEK_DAYS.
      */
-    void Operational_Time_Marker(const nlohmann::json& j, std::string day, int prefix_number);
-
-public:
-    void assignLectureTutorial(const Lecture &lecture){
-        for(auto time: lecture.lecture_schedule){
-            is_available[time] = 0;
-            assignment[time] = lecture.course_code;
-        }
-        return;
-    }
-
-    static bool compareByCapacity(const Venue& a, const Venue& b) {
-        return a.capacity < b.capacity;
-    }
+    void Operational_Time_Marker(const nlohmann::json& j, const char *day, int day_index);
 };
 
 class Course {
 public:
-    std::string course_code;
-    std::string course_name;
-    std::vector<int> lecture_schedule;
-    std::vector<int> tutorial_schedule;
+    uint32_t course_code; // IDs in NamePools
+    uint32_t section;
+    uint32_t course_name;
+    int lecture_pattern;  // IDs in the SchedulePatternTable
+    int tutorial_pattern;
     int tutorial_count;
     int students_registered;
-    bool is_modular;
+    TermPart term_part;
 
-    Course(const std::string Course_Code, const std::string Course_Name, const std::vector<int> Lecture_Schedule, const std::vector<int> Tutorial_Schedule, int Tutorial_Count, int Students_Registered, const bool Is_Modular)
+    Course(const uint32_t Course_Code, const uint32_t Section, const uint32_t Course_Name, const int Lecture_Pattern, const int Tutorial_Pattern, int Tutorial_Count, int Students_Registered, const TermPart Term_Part)
         :
         course_code(Course_Code),
+        section(Section),
         course_name(Course_Name),
-        lecture_schedule(Lecture_Schedule),
-        tutorial_schedule(Tutorial_Schedule),
+        lecture_pattern(Lecture_Pattern),
+        tutorial_pattern(Tutorial_Pattern),
         tutorial_count(Tutorial_Count),
         students_registered(Students_Registered),
-        is_modular(Is_Modular)
+        term_part(Term_Part)
         {}
-
-    void Course::Append_course_code(const std::string new_code);
-    void Course::Append_course_name(const std::string new_name);
-    void Course::Update_max_registered_students(const int new_students_registered);
-    void Course::Update_max_tutorial_count(const int new_toturial_count);
 };
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "ejection_repair.hpp"
+#include "sort_order.hpp"
+
+namespace {
+
+/**
+ * Occupancy of the halls by the given lectures, kept apart from the other bookings of the venue
+ * table so lectures can be lifted and placed while chains are explored.
+ */
+class EjectionChains {
+public:
+    long long nodes = 0;
+    bool out_of_nodes = false;
+    bool timed_out = false;
+
+    EjectionChains(const std::vector<Lecture> &lectures, const VenueTable &venues, const std::vector<int> &buildings, const SchedulePatternTable &schedule_patterns, const RepairOptions &options);
+
+    bool stopped() const { return out_of_nodes || timed_out; }
+
+    int hall_of(int lecture) const { return hall[lecture]; }
+
+    // Tries to give an unassigned lecture a hall with at most `depth` displaced lectures.
+    bool repair(int lecture, int depth);
+
+private:
+    const VenueTable &venues;
+    std::vector<int> buildings;
+    long long node_limit;
+    bool has_deadline;
+    std::chrono::steady_clock::time_point deadline;
+
+    std::vector<int> sizes;
+    std::vector<SlotMask> masks;
+    std::vector<int> hall;
+    std::vector<char> in_chain;
+    std::vector<SlotMask> others;          // per venue: bookings not made for these lectures
+    std::vector<std::vector<int>> on_venue;
+
+    void place(int lecture, int venue);
+    void lift(int lecture);
+    bool search(int lecture, int depth);
+};
+
+EjectionChains::EjectionChains(const std::vector<Lecture> &lectures, const VenueTable &venues, const std::vector<int> &buildings, const SchedulePatternTable &schedule_patterns, const RepairOptions &options)
+    : venues(venues), buildings(buildings), node_limit(options.node_limit), has_deadline(options.time_budget_ms > 0),
+      deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, options.time_budget_ms)))
+{
+    int lecture_count = lectures.size();
+    others = venues.booked;
+    on_venue.resize(venues.size());
+    hall.assign(lecture_count, -1);
+    in_chain.assign(lecture_count, 0);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        sizes.push_back(lectures[lecture].students_registered);
+        masks.push_back(schedule_patterns.slots(lectures[lecture].lecture_pattern));
+        int venue = lectures[lecture].assignment;
+        if(venue == -1)continue;
+        others[venue].remove(masks[lecture]);
+        hall[lecture] = venue;
+        on_venue[venue].push_back(lecture);
+    }
+}
+
+void EjectionChains::place(int lecture, int venue){
+    hall[lecture] = venue;
+    on_venue[venue].push_back(lecture);
+}
+
+void EjectionChains::lift(int lecture){
+    std::vector<int> &holders = on_venue[hall[lecture]];
+    *std::find(holders.begin(), holders.end(), lecture) = holders.back();
+    holders.pop_back();
+    hall[lecture] = -1;
+}
+
+bool EjectionChains::repair(int lecture, int depth){
+    in_chain[lecture] = 1;
+    bool placed = search(lecture, depth);
+    in_chain[lecture] = 0;
+    return placed;
+}
+
+bool EjectionChains::search(int lecture, int depth){
+    const SlotMask &slots = masks[lecture];
+    for(auto building: buildings){
+        const VenueTable::BuildingRange &range = venues.building_ranges[building];
+        int first = range.begin + venues.capacity_indexes[building].lower_bound_rank(sizes[lecture]);
+        for(int venue = first; venue < range.end; venue++){
+            if(nodes >= node_limit)out_of_nodes = true;
+            if(has_deadline && (nodes & 63) == 0 && std::chrono::steady_clock::now() >= deadline)timed_out = true;
+            if(stopped())return false;
+            nodes++;
+            if(!venues.opening_templates[venues.opening_ids[venue]].contains(slots) || others[venue].intersects(slots))continue;
+
+            int blocker = -1;
+            int blockers = 0;
+            for(auto other: on_venue[venue]){
+                if(!masks[other].intersects(slots))continue;
+                blocker = other;
+                blockers++;
+            }
+            if(blockers == 0){
+                place(lecture, venue);
+                return true;
+            }
+            if(blockers > 1 || depth == 0 || in_chain[blocker])continue;
+
+            // Take the blocker's hall and look for a new home for the blocker one level down.
+            lift(blocker);
+            place(lecture, venue);
+            in_chain[blocker] = 1;
+            bool moved = search(blocker, depth - 1);
+            in_chain[blocker] = 0;
+            if(moved)return true;
+            lift(lecture);
+            place(blocker, venue);
+        }
+    }
+    return false;
+}
+
+}
+
+RepairResult repair_unassigned_lectures(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, const RepairOptions &options){
+    RepairResult result;
+    std::vector<int> unplaced;
+    for(int lecture = 0; lecture < (int)lectures.size(); lecture++){
+        if(lectures[lecture].assignment == -1)unplaced.push_back(lecture);
+    }
+    result.unassigned_before = unplaced.size();
+    if(unplaced.empty() || options.node_limit <= 0)return result;
+
+    // Large lectures have the fewest halls to choose from, so they go first.
+    counting_sort_indices(unplaced, [&lectures](int ind){ return -lectures[ind].students_registered; });
+
+    EjectionChains chains(lectures, venues, venues.resolve_buildings(lecture_building_priority_order), schedule_patterns, options);
+    for(int depth = 0; depth <= options.max_depth && !chains.stopped(); depth++){
+        std::vector<int> still_unplaced;
+        for(auto lecture: unplaced){
+            if(chains.stopped() || !chains.repair(lecture, depth))still_unplaced.push_back(lecture);
+        }
+        unplaced.swap(still_unplaced);
+    }
+    result.nodes = chains.nodes;
+    result.out_of_nodes = chains.out_of_nodes;
+    result.timed_out = chains.timed_out;
+
+    // Release every moved lecture before booking again, so no new booking is cleared by a release.
+    std::vector<int> moved;
+    for(int lecture = 0; lecture < (int)lectures.size(); lecture++){
+        if(chains.hall_of(lecture) != lectures[lecture].assignment)moved.push_back(lecture);
+    }
+    for(auto lecture: moved){
+        if(lectures[lecture].assignment == -1)continue;
+        venues.unbook(lectures[lecture].assignment, lectures[lecture].course_code, lectures[lecture].section, schedule_patterns.slots(lectures[lecture].lecture_pattern));
+    }
+    for(auto lecture: moved){
+        if(lectures[lecture].assignment == -1)result.repaired++;
+        lectures[lecture].assignLectureHall(chains.hall_of(lecture));
+        venues.book(chains.hall_of(lecture), lectures[lecture].course_code, lectures[lecture].section, schedule_patterns.slots(lectures[lecture].lecture_pattern));
+    }
+    return result;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+
+/**
+ * @brief Budget of the repair. It stops, keeping what it placed, once it has examined node_limit
+ * halls, so the same input always gives the same schedule. A wall-clock budget can be added for
+ * interactive use; the result then depends on the speed of the machine.
+ */
+struct RepairOptions {
+    int max_depth = 3;            // displaced lectures per chain
+    long long node_limit = 50000; // halls examined, 0: no repair
+    int time_budget_ms = 0;       // 0: no wall-clock limit
+};
+
+struct RepairResult {
+    int unassigned_before = 0;
+    int repaired = 0;         // lectures placed by the repair
+    long long nodes = 0;      // halls examined
+    bool out_of_nodes = false;
+    bool timed_out = false;
+};
+
+/**
+ * @brief Places unassigned lectures by ejection chains.
+ * For an unassigned lecture the repair looks for a hall of the priority buildings that is free, or
+ * held by exactly one of the other lectures in its slots; that lecture is moved on in turn, up to
+ * max_depth times. Chains are searched by increasing depth, so short chains win, and every chain
+ * found is applied at once, so the lecture list and venue table stay consistent when the budget
+ * runs out. Halls booked for anything other than these lectures are never touched.
+ */
+RepairResult repair_unassigned_lectures(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, const RepairOptions &options);
@@ -0,0 +1,398 @@
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+#include "exact_allocation.hpp"
+#include "lecture_allocation.hpp"
+#include "sort_order.hpp"
+
+namespace {
+
+constexpr int UNDECIDED = -2;
+constexpr int UNPLACED = -1;
+
+// Deepest branching level; below it the remaining lectures are completed without recursion, so the
+// stack stays small however many lectures there are.
+constexpr int MAX_SEARCH_DEPTH = 1024;
+
+/**
+ * Branch-and-bound over one set of lectures. Eligible halls are ranked by capacity, so the lowest
+ * set bit of a lecture's feasible set is its cheapest hall.
+ */
+class ExactSolver {
+public:
+    ExactSolver(const std::vector<Lecture> &lectures, const VenueTable &venues, const std::vector<int> &buildings, const SchedulePatternTable &schedule_patterns, const ExactAllocationLimits &limits);
+
+    // Starts the search with a known assignment (venue ID per lecture, -1 when unassigned) as incumbent.
+    void seed(const std::vector<int> &venue_of_lecture, const VenueTable &venues);
+
+    ExactAllocationResult solve();
+
+    // Venue ID chosen for each lecture, -1 when unassigned.
+    std::vector<int> best_venues() const;
+
+private:
+    int lecture_count = 0;
+    int rank_count = 0;
+    int words = 0;
+
+    std::vector<int> rank_venue;
+    std::vector<int> rank_capacity;
+    std::vector<int> rank_template;
+    std::vector<SlotMask> rank_booked; // bookings so far, used to spot interchangeable halls
+
+    std::vector<int> sizes;
+    std::vector<SlotMask> masks;
+    std::vector<std::vector<int>> lecture_slots;
+    std::vector<uint64_t> domains; // lecture-major bitsets over ranks
+    std::vector<uint64_t> busy;    // slot-major bitsets of ranks booked during the search
+    std::vector<uint64_t> open_at; // slot-major bitsets of ranks free before the search
+    std::vector<int> demand;       // undecided lectures covering each slot
+
+    std::vector<int> current;      // rank per lecture, UNPLACED or UNDECIDED
+    int current_unassigned = 0;
+    long long current_waste = 0;
+
+    std::vector<int> best;
+    int best_unassigned = INT_MAX;
+    long long best_waste = LLONG_MAX;
+
+    long long nodes = 0;
+    long long node_limit = 0;
+    int time_limit_ms = 0;
+    std::chrono::steady_clock::time_point deadline;
+    bool stopped = false;
+    bool truncated = false;  // some branch was completed past MAX_SEARCH_DEPTH
+    bool diving = false;
+
+    std::vector<uint64_t> branch_sets; // one feasible set per search depth
+    std::vector<uint64_t> scratch;
+    std::vector<long long> min_wastes;
+
+    // Stacks shared by all depths; every node pushes above the entries of its ancestors and pops
+    // its own before returning, so nodes do not allocate once the stacks have grown.
+    std::vector<int> forced;      // lectures left without a hall, decided unplaced together
+    std::vector<int> tried;       // ranks branched on, for the symmetry check
+
+    // Ranks still free for a lecture given the current bookings.
+    void feasible(int lecture, uint64_t *out) const;
+
+    void decide(int lecture, int rank);
+    void undo(int lecture, int rank);
+
+    void record();
+
+    // Gives every undecided lecture its cheapest free hall in index order, records the leaf and undoes it.
+    void complete();
+
+    void search(int undecided, int depth);
+};
+
+ExactSolver::ExactSolver(const std::vector<Lecture> &lectures, const VenueTable &venues, const std::vector<int> &buildings, const SchedulePatternTable &schedule_patterns, const ExactAllocationLimits &limits)
+    : node_limit(limits.node_limit), time_limit_ms(limits.time_limit_ms)
+{
+    for(auto building: buildings){
+        for(int venue = venues.building_ranges[building].begin; venue < venues.building_ranges[building].end; venue++){
+            rank_venue.push_back(venue);
+        }
+    }
+    counting_sort_indices(rank_venue, [&venues](int venue){ return venues.capacities[venue]; });
+
+    rank_count = rank_venue.size();
+    words = (rank_count + 63) / 64;
+    for(auto venue: rank_venue){
+        rank_capacity.push_back(venues.capacities[venue]);
+        rank_template.push_back(venues.opening_ids[venue]);
+        rank_booked.push_back(venues.booked[venue]);
+    }
+
+    lecture_count = lectures.size();
+    domains.assign((size_t)lecture_count * words, 0);
+    lecture_slots.resize(lecture_count);
+    demand.assign(TERM_SLOTS, 0);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        sizes.push_back(lectures[lecture].students_registered);
+        masks.push_back(schedule_patterns.slots(lectures[lecture].lecture_pattern));
+        masks.back().for_each_slot([&](int slot){
+            lecture_slots[lecture].push_back(slot);
+            demand[slot]++;
+        });
+
+        for(int rank = 0; rank < rank_count; rank++){
+            if(rank_capacity[rank] >= sizes[lecture] && venues.is_free(rank_venue[rank], masks[lecture])){
+                domains[(size_t)lecture * words + (rank >> 6)] |= uint64_t(1) << (rank & 63);
+            }
+        }
+    }
+
+    busy.assign((size_t)TERM_SLOTS * words, 0);
+    open_at.assign((size_t)TERM_SLOTS * words, 0);
+    for(int rank = 0; rank < rank_count; rank++){
+        venues.availability(rank_venue[rank]).for_each_slot([&](int slot){
+            open_at[(size_t)slot * words + (rank >> 6)] |= uint64_t(1) << (rank & 63);
+        });
+    }
+
+    current.assign(lecture_count, UNDECIDED);
+    branch_sets.assign((size_t)(lecture_count + 1) * words, 0);
+    scratch.assign(words, 0);
+}
+
+void ExactSolver::seed(const std::vector<int> &venue_of_lecture, const VenueTable &venues){
+    std::vector<int> rank_of(venues.size(), UNPLACED);
+    for(int rank = 0; rank < rank_count; rank++)rank_of[rank_venue[rank]] = rank;
+
+    best.assign(lecture_count, UNPLACED);
+    best_unassigned = 0;
+    best_waste = 0;
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        int venue = venue_of_lecture[lecture];
+        best[lecture] = venue == -1 ? UNPLACED : rank_of[venue];
+        if(best[lecture] == UNPLACED)best_unassigned++;
+        else best_waste += rank_capacity[best[lecture]] - sizes[lecture];
+    }
+}
+
+void ExactSolver::feasible(int lecture, uint64_t *out) const {
+    const uint64_t *domain = &domains[(size_t)lecture * words];
+    for(int w = 0; w < words; w++){
+        uint64_t free_ranks = domain[w];
+        for(auto slot: lecture_slots[lecture]){
+            if(!free_ranks)break;
+            free_ranks &= ~busy[(size_t)slot * words + w];
+        }
+        out[w] = free_ranks;
+    }
+}
+
+void ExactSolver::decide(int lecture, int rank){
+    current[lecture] = rank;
+    for(auto slot: lecture_slots[lecture])demand[slot]--;
+
+    if(rank == UNPLACED){
+        current_unassigned++;
+        return;
+    }
+    for(auto slot: lecture_slots[lecture]){
+        busy[(size_t)slot * words + (rank >> 6)] |= uint64_t(1) << (rank & 63);
+    }
+    rank_booked[rank] |= masks[lecture];
+    current_waste += rank_capacity[rank] - sizes[lecture];
+}
+
+void ExactSolver::undo(int lecture, int rank){
+    current[lecture] = UNDECIDED;
+    for(auto slot: lecture_slots[lecture])demand[slot]++;
+
+    if(rank == UNPLACED){
+        current_unassigned--;
+        return;
+    }
+    for(auto slot: lecture_slots[lecture]){
+        busy[(size_t)slot * words + (rank >> 6)] &= ~(uint64_t(1) << (rank & 63));
+    }
+    rank_booked[rank].remove(masks[lecture]);
+    current_waste -= rank_capacity[rank] - sizes[lecture];
+}
+
+void ExactSolver::record(){
+    if(current_unassigned < best_unassigned || (current_unassigned == best_unassigned && current_waste < best_waste)){
+        best = current;
+        best_unassigned = current_unassigned;
+        best_waste = current_waste;
+    }
+}
+
+void ExactSolver::complete(){
+    truncated = true;
+    size_t base = forced.size();
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        if(current[lecture] != UNDECIDED)continue;
+        feasible(lecture, scratch.data());
+        int rank = UNPLACED;
+        for(int w = 0; w < words && rank == UNPLACED; w++){
+            if(scratch[w])rank = w * 64 + ctz64(scratch[w]);
+        }
+        decide(lecture, rank);
+        forced.push_back(lecture);
+    }
+    record();
+    while(forced.size() > base){
+        int lecture = forced.back();
+        forced.pop_back();
+        undo(lecture, current[lecture]);
+    }
+}
+
+void ExactSolver::search(int undecided, int depth){
+    // The dive is not held to the node limit, but both it and the full search stop at the deadline.
+    // A node scans every lecture, so reading the clock on each one costs little.
+    nodes++;
+    if(std::chrono::steady_clock::now() >= deadline)stopped = true;
+    if(!diving && nodes >= node_limit)stopped = true;
+    if(stopped)return;
+
+    if(undecided == 0){
+        record();
+        return;
+    }
+    if(depth == MAX_SEARCH_DEPTH){
+        complete();
+        return;
+    }
+
+    // Branch on the undecided lecture with the fewest free halls (larger lectures first on ties);
+    // lectures with none left can only stay unassigned.
+    int chosen = -1;
+    int chosen_count = INT_MAX;
+    size_t empty_base = forced.size();
+    min_wastes.clear();
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        if(current[lecture] != UNDECIDED)continue;
+
+        feasible(lecture, scratch.data());
+        int count = 0;
+        int first = -1;
+        for(int w = 0; w < words; w++){
+            if(scratch[w] && first == -1)first = w * 64 + ctz64(scratch[w]);
+            count += popcount64(scratch[w]);
+        }
+
+        if(count == 0){
+            forced.push_back(lecture);
+            continue;
+        }
+        min_wastes.push_back(rank_capacity[first] - sizes[lecture]);
+        if(count < chosen_count || (count == chosen_count && sizes[lecture] > sizes[chosen])){
+            chosen = lecture;
+            chosen_count = count;
+        }
+    }
+
+    // Every slot needs one free hall per undecided lecture covering it; the shortfall must go unassigned.
+    int excess = 0;
+    for(int slot = 0; slot < TERM_SLOTS; slot++){
+        if(demand[slot] <= excess)continue;
+        int supply = 0;
+        for(int w = 0; w < words; w++){
+            supply += popcount64(open_at[(size_t)slot * words + w] & ~busy[(size_t)slot * words + w]);
+        }
+        excess = std::max(excess, demand[slot] - supply);
+    }
+
+    int empty_count = forced.size() - empty_base;
+    int unassigned_bound = current_unassigned + std::max(empty_count, excess);
+    bool pruned = unassigned_bound > best_unassigned;
+    if(unassigned_bound == best_unassigned){
+        // No further lecture may be dropped beyond best_unassigned, so all but `droppable` of the
+        // open lectures pay at least their cheapest hall.
+        int droppable = best_unassigned - current_unassigned - empty_count;
+        long long waste_bound = current_waste;
+        int paying = (int)min_wastes.size() - droppable;
+        if(paying > 0){
+            std::nth_element(min_wastes.begin(), min_wastes.begin() + (paying - 1), min_wastes.end());
+            for(int ind = 0; ind < paying; ind++)waste_bound += min_wastes[ind];
+        }
+        if(waste_bound >= best_waste)pruned = true;
+    }
+
+    if(pruned || empty_count > 0){
+        if(!pruned){
+            for(size_t ind = empty_base; ind < forced.size(); ind++)decide(forced[ind], UNPLACED);
+            search(undecided - empty_count, depth + 1);
+            for(size_t ind = empty_base; ind < forced.size(); ind++)undo(forced[ind], UNPLACED);
+        }
+        forced.resize(empty_base);
+        return;
+    }
+
+    uint64_t *branch = &branch_sets[(size_t)(lecture_count - undecided) * words];
+    feasible(chosen, branch);
+
+    size_t tried_base = tried.size();
+    for(int w = 0; w < words; w++){
+        uint64_t ranks = branch[w];
+        while(ranks){
+            int rank = w * 64 + ctz64(ranks);
+            ranks &= ranks - 1;
+
+            // Halls with the same capacity, opening hours and bookings lead to the same subtrees.
+            bool symmetric = false;
+            for(size_t ind = tried_base; ind < tried.size(); ind++){
+                int other = tried[ind];
+                if(rank_capacity[other] == rank_capacity[rank] && rank_template[other] == rank_template[rank] && rank_booked[other] == rank_booked[rank]){
+                    symmetric = true;
+                    break;
+                }
+            }
+            if(symmetric)continue;
+            tried.push_back(rank);
+
+            decide(chosen, rank);
+            search(undecided - 1, depth + 1);
+            undo(chosen, rank);
+            if(stopped || diving){
+                tried.resize(tried_base);
+                return;
+            }
+        }
+    }
+    tried.resize(tried_base);
+
+    decide(chosen, UNPLACED);
+    search(undecided - 1, depth + 1);
+    undo(chosen, UNPLACED);
+}
+
+ExactAllocationResult ExactSolver::solve(){
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, time_limit_ms));
+
+    // A first dive along the cheapest branches may improve on the seeded incumbent; it ignores the
+    // node limit but not the deadline. The full search then starts from the better of the two.
+    diving = true;
+    search(lecture_count, 0);
+    diving = false;
+
+    if(!stopped)search(lecture_count, 0);
+
+    ExactAllocationResult result;
+    result.unassigned = best_unassigned;
+    result.wasted_seats = best_waste;
+    result.nodes = nodes;
+    result.optimal = !stopped && !truncated;
+    return result;
+}
+
+std::vector<int> ExactSolver::best_venues() const {
+    std::vector<int> venues(lecture_count, -1);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        if(best[lecture] >= 0)venues[lecture] = rank_venue[best[lecture]];
+    }
+    return venues;
+}
+
+}
+
+ExactAllocationResult exact_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, const ExactAllocationLimits &limits){
+    std::vector<int> buildings = venues.resolve_buildings(lecture_building_priority_order);
+
+    // The greedy's assignment (with no convenience headroom, which wastes the fewest seats) is the
+    // first incumbent, so the search never returns anything worse than it.
+    std::vector<Lecture> greedy_lectures = lectures;
+    VenueTable greedy_venues = venues;
+    core_lecture_allocation_logic(greedy_lectures, greedy_venues, lecture_building_priority_order, 0, schedule_patterns);
+    std::vector<int> greedy_assignment(lectures.size());
+    for(size_t lecture = 0; lecture < lectures.size(); lecture++)greedy_assignment[lecture] = greedy_lectures[lecture].assignment;
+
+    ExactSolver solver(lectures, venues, buildings, schedule_patterns, limits);
+    solver.seed(greedy_assignment, venues);
+    ExactAllocationResult result = solver.solve();
+
+    std::vector<int> chosen = solver.best_venues();
+    for(int lecture = 0; lecture < (int)lectures.size(); lecture++){
+        if(chosen[lecture] == -1)continue;
+        lectures[lecture].assignLectureHall(chosen[lecture]);
+        venues.book(chosen[lecture], lectures[lecture].course_code, lectures[lecture].section, schedule_patterns.slots(lectures[lecture].lecture_pattern));
+    }
+    return result;
+}
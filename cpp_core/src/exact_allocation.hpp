@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+
+/**
+ * @brief Limits of the exact search; the best assignment found so far is kept when one is hit.
+ */
+struct ExactAllocationLimits {
+    long long node_limit = 2000000;
+    int time_limit_ms = 5000;
+};
+
+struct ExactAllocationResult {
+    int unassigned = 0;
+    long long wasted_seats = 0;
+    long long nodes = 0;
+    bool optimal = false; // the search finished inside the limits
+};
+
+/**
+ * @brief Assigns lectures to halls by branch-and-bound, minimising unassigned lectures first and
+ * total wasted seats (capacity - students) second.
+ * Only halls of the priority buildings are used, as in core_lecture_allocation_logic, and halls
+ * already booked in the VenueTable stay booked. Each lecture's domain is a bitset over halls ranked
+ * by capacity; the bound combines lectures left without a feasible hall, the per-slot excess of
+ * lectures over free halls, and the cheapest remaining hall of every open lecture. The search starts
+ * with the greedy's assignment as incumbent, so a search cut short by the limits never does worse
+ * than the greedy. Branching stops 1024 levels deep, where the rest of a branch is completed
+ * greedily (the result is then not reported optimal).
+ * @return The quality of the assignment written into lectures and venues.
+ */
+ExactAllocationResult exact_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, const ExactAllocationLimits &limits);
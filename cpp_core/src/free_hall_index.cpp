@@ -0,0 +1,126 @@
+#include <vector>
+#include "free_hall_index.hpp"
+
+FreeHallIndex::FreeHallIndex(const VenueTable &venues, int building_id){
+    const VenueTable::BuildingRange &range = venues.building_ranges[building_id];
+    int hall_count = range.end - range.begin;
+    words = (hall_count + 63) / 64;
+    first_venue = range.begin;
+
+    capacity = venues.capacity_indexes[building_id];
+    free_rows.assign((size_t)TERM_SLOTS * words, 0);
+    for(int rank = 0; rank < hall_count; rank++){
+        venues.availability(range.begin + rank).for_each_slot([&](int slot){
+            free_rows[(size_t)slot * words + (rank >> 6)] |= uint64_t(1) << (rank & 63);
+        });
+    }
+}
+
+int FreeHallIndex::slot_list(const SlotMask &slots, TimeGrid::slot_index *out){
+    int count = 0;
+    slots.for_each_slot([&](int slot){
+        out[count++] = (TimeGrid::slot_index)slot;
+    });
+    return count;
+}
+
+uint64_t FreeHallIndex::free_word(const TimeGrid::slot_index *slot_ids, int slot_count, int w, int from, int to) const {
+    uint64_t acc = ~uint64_t(0);
+    if(w == (from >> 6))acc &= ~uint64_t(0) << (from & 63);
+    if(w == ((to - 1) >> 6) && (to & 63))acc &= ~(~uint64_t(0) << (to & 63));
+
+    for(int ind = 0; ind < slot_count && acc; ind++){
+        acc &= free_rows[(size_t)slot_ids[ind] * words + w];
+    }
+    return acc;
+}
+
+int FreeHallIndex::first_free(const SlotMask &slots, int from, int to) const {
+    if(from >= to)return -1;
+
+    TimeGrid::slot_index slot_ids[TERM_SLOTS];
+    int slot_count = slot_list(slots, slot_ids);
+
+    for(int w = from >> 6; w <= ((to - 1) >> 6); w++){
+        uint64_t acc = free_word(slot_ids, slot_count, w, from, to);
+        if(acc)return w * 64 + ctz64(acc);
+    }
+    return -1;
+}
+
+int FreeHallIndex::last_free(const SlotMask &slots, int from, int to) const {
+    if(from >= to)return -1;
+
+    TimeGrid::slot_index slot_ids[TERM_SLOTS];
+    int slot_count = slot_list(slots, slot_ids);
+
+    for(int w = (to - 1) >> 6; w >= (from >> 6); w--){
+        uint64_t acc = free_word(slot_ids, slot_count, w, from, to);
+        if(acc)return w * 64 + msb64(acc);
+    }
+    return -1;
+}
+
+int FreeHallIndex::first_free_n(const SlotMask &slots, int from, int to, int count, int *out) const {
+    if(from >= to || count <= 0)return 0;
+
+    TimeGrid::slot_index slot_ids[TERM_SLOTS];
+    int slot_count = slot_list(slots, slot_ids);
+
+    int found = 0;
+    for(int w = from >> 6; w <= ((to - 1) >> 6) && found < count; w++){
+        uint64_t acc = free_word(slot_ids, slot_count, w, from, to);
+        while(acc && found < count){
+            out[found++] = w * 64 + ctz64(acc);
+            acc &= acc - 1;
+        }
+    }
+    return found;
+}
+
+int FreeHallIndex::last_free_n(const SlotMask &slots, int from, int to, int count, int *out) const {
+    if(from >= to || count <= 0)return 0;
+
+    TimeGrid::slot_index slot_ids[TERM_SLOTS];
+    int slot_count = slot_list(slots, slot_ids);
+
+    int found = 0;
+    for(int w = (to - 1) >> 6; w >= (from >> 6) && found < count; w--){
+        uint64_t acc = free_word(slot_ids, slot_count, w, from, to);
+        while(acc && found < count){
+            int bit = msb64(acc);
+            out[found++] = w * 64 + bit;
+            acc &= ~(uint64_t(1) << bit);
+        }
+    }
+    return found;
+}
+
+int FreeHallIndex::count_free(const SlotMask &slots, int from, int to) const {
+    if(from >= to)return 0;
+
+    TimeGrid::slot_index slot_ids[TERM_SLOTS];
+    int slot_count = slot_list(slots, slot_ids);
+
+    int count = 0;
+    for(int w = from >> 6; w <= ((to - 1) >> 6); w++){
+        count += popcount64(free_word(slot_ids, slot_count, w, from, to));
+    }
+    return count;
+}
+
+bool FreeHallIndex::is_free(int rank, const SlotMask &slots) const {
+    uint64_t bit = uint64_t(1) << (rank & 63);
+    bool free_everywhere = true;
+    slots.for_each_slot([&](int slot){
+        if(!(free_rows[(size_t)slot * words + (rank >> 6)] & bit))free_everywhere = false;
+    });
+    return free_everywhere;
+}
+
+void FreeHallIndex::occupy(int rank, const SlotMask &slots){
+    uint64_t bit = uint64_t(1) << (rank & 63);
+    slots.for_each_slot([&](int slot){
+        free_rows[(size_t)slot * words + (rank >> 6)] &= ~bit;
+    });
+}
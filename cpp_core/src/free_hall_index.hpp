@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "venue_table.hpp"
+
+/**
+ * @class FreeHallIndex
+ * @brief Slot-major index of the free halls of one building.
+ * Halls are ranked by ascending capacity (their order in the VenueTable); for every slot of the term the index keeps a
+ * bitset with bit r set when the hall of rank r is open and unbooked in that slot.
+ * Finding a hall free for a whole lecture is an AND of the lecture's slot rows,
+ * one 64-hall word at a time, followed by a count-trailing-zeros.
+ */
+class FreeHallIndex {
+public:
+    FreeHallIndex() = default;
+
+    /**
+     * @brief Builds the index from the current availability of one building's halls.
+     * @param venues The venue table; its capacity order within the building gives the ranks.
+     * @param building_id The building to index.
+     */
+    FreeHallIndex(const VenueTable &venues, int building_id);
+
+    int size() const { return capacity.size(); }
+
+    // Venue ID of the hall with the given rank.
+    int venue_at(int rank) const { return first_venue + rank; }
+
+    int capacity_at(int rank) const { return capacity.capacity_at(rank); }
+
+    // First rank whose hall has capacity >= seats.
+    int lower_bound_rank(int seats) const { return capacity.lower_bound_rank(seats); }
+
+    /**
+     * @brief Lowest rank in [from, to) whose hall is free in every slot of the mask.
+     * @return The rank, or -1 when no hall in the range fits.
+     */
+    int first_free(const SlotMask &slots, int from, int to) const;
+
+    /**
+     * @brief Highest rank in [from, to) whose hall is free in every slot of the mask.
+     * @return The rank, or -1 when no hall in the range fits.
+     */
+    int last_free(const SlotMask &slots, int from, int to) const;
+
+    /**
+     * @brief Collects up to `count` ranks in [from, to) whose halls are free in every slot of the mask,
+     * lowest ranks first, in one pass over the slot rows.
+     * @return How many ranks were written to `out`.
+     */
+    int first_free_n(const SlotMask &slots, int from, int to, int count, int *out) const;
+
+    // As first_free_n, highest ranks first.
+    int last_free_n(const SlotMask &slots, int from, int to, int count, int *out) const;
+
+    // Number of ranks in [from, to) whose halls are free in every slot of the mask.
+    int count_free(const SlotMask &slots, int from, int to) const;
+
+    // True when the hall with the given rank is free in every slot of the mask.
+    bool is_free(int rank, const SlotMask &slots) const;
+
+    // Marks the hall with the given rank as booked for the slots of the mask.
+    void occupy(int rank, const SlotMask &slots);
+
+private:
+    int words = 0;                   // 64-bit words per slot row
+    int first_venue = 0;             // venue ID of rank 0
+    CapacityIndex capacity;          // the building's index from the VenueTable
+    std::vector<uint64_t> free_rows; // TERM_SLOTS rows of `words` words
+
+    // Collects the set slots of a mask into `out`, returns how many there are.
+    static int slot_list(const SlotMask &slots, TimeGrid::slot_index *out);
+
+    // AND of the given slot rows for word w, restricted to ranks [from, to).
+    uint64_t free_word(const TimeGrid::slot_index *slot_ids, int slot_count, int w, int from, int to) const;
+};
@@ -1,5 +1,135 @@
 #pragma once
-#include <string>
-#include <vector>
+#include <string_view>
+#include <charconv>
+#include "slot_mask.hpp"
 
-std::vector<int> timeString_to_timeINT(std::string timeStr);
\ No newline at end of file
+/**
+ * @brief Reasons a schedule string such as "MWF 09:00-10:00, Th 14:00-15:15" can be rejected.
+ */
+enum class ScheduleParseError {
+    None,
+    MissingDays,   // a piece does not start with day letters
+    UnknownDay,    // a day code missing from WEEK_DAYS
+    BadTime,       // a time that is not H:MM or HH:MM within 00:00-24:00
+    EmptyRange,    // an end time that is not after the start time
+    BufferFull     // the caller's slot buffer is too small
+};
+
+// Name of a parse error as reported in the output ("badTime", ...).
+const char *schedule_parse_error_name(ScheduleParseError error);
+
+inline bool digit_at(const char *at, const char *last){
+    return at < last && *at >= '0' && *at <= '9';
+}
+
+// Reads "H:MM" or "HH:MM" at pos into minutes since midnight and advances pos.
+// Both numbers must start with a digit: from_chars would otherwise take a leading '-'.
+inline bool parse_clock(std::string_view text, size_t &pos, int &minutes){
+    const char *first = text.data() + pos;
+    const char *last = text.data() + text.size();
+
+    int hour = 0;
+    if(!digit_at(first, last))return false;
+    auto [hour_end, hour_ec] = std::from_chars(first, last, hour);
+    if(hour_ec != std::errc() || hour < 0 || hour_end - first > 2 || hour_end == last || *hour_end != ':')return false;
+
+    int minute = 0;
+    if(!digit_at(hour_end + 1, last))return false;
+    auto [minute_end, minute_ec] = std::from_chars(hour_end + 1, last, minute);
+    if(minute_ec != std::errc() || minute < 0 || minute_end - hour_end != 3 || minute > 59)return false;
+
+    minutes = hour * 60 + minute;
+    if(minutes > 24 * 60)return false;
+    pos = minute_end - text.data();
+    return true;
+}
+
+// Reads an exactly five-character "HH:MM" (00:00-24:00) into minutes since midnight.
+inline bool parse_fixed_clock(std::string_view text, int &minutes){
+    if(text.size() != 5 || text[2] != ':')return false;
+    for(int ind: {0, 1, 3, 4}){
+        if(text[ind] < '0' || text[ind] > '9')return false;
+    }
+    int hour = (text[0] - '0') * 10 + (text[1] - '0');
+    int minute = (text[3] - '0') * 10 + (text[4] - '0');
+    if(minute > 59 || hour * 60 + minute > 24 * 60)return false;
+
+    minutes = hour * 60 + minute;
+    return true;
+}
+
+/**
+ * @brief Parses a schedule string without allocating and reports every day's slot range to a sink.
+ * Pieces are separated by commas; each piece is a run of day letters followed by a time range.
+ * A range covers every slot of the TimeGrid it overlaps, so 14:00-15:15 on a half-hour grid is [14:00, 15:30).
+ * @param schedule The schedule text.
+ * @param sink Called as sink(day_index, first_slot, end_slot) with the day's position in WEEK_DAYS
+ *             and slot indices within the day; returning false stops parsing with BufferFull.
+ * @return ScheduleParseError::None on success, otherwise the first problem found.
+ */
+template <typename Sink>
+ScheduleParseError parse_schedule_ranges(std::string_view schedule, Sink &&sink){
+    size_t pos = 0;
+    size_t length = schedule.size();
+
+    while(pos < length){
+        while(pos < length && schedule[pos] == ' ')pos++;
+        if(pos < length && schedule[pos] == ','){
+            pos++;
+            continue;
+        }
+        if(pos == length)break;
+
+        // Day codes, read left to right through DAY_CODES; a lower-case letter after a capital
+        // makes it a two-letter code such as "Th" or "Sa".
+        unsigned day_bits = 0;
+        while(pos < length && schedule[pos] != ' ' && !(schedule[pos] >= '0' && schedule[pos] <= '9')){
+            char first = schedule[pos];
+            if(first < 'A' || first > 'Z')return ScheduleParseError::UnknownDay;
+            int second = (pos + 1 < length && schedule[pos + 1] >= 'a' && schedule[pos + 1] <= 'z') ? schedule[pos + 1] - 'a' + 1 : 0;
+            int day = DAY_CODES.day[first - 'A'][second];
+            if(day < 0)return ScheduleParseError::UnknownDay;
+            day_bits |= 1u << day;
+            pos += second ? 2 : 1;
+        }
+        if(day_bits == 0)return ScheduleParseError::MissingDays;
+
+        while(pos < length && schedule[pos] == ' ')pos++;
+
+        int start = 0, end = 0;
+        if(!parse_clock(schedule, pos, start))return ScheduleParseError::BadTime;
+        while(pos < length && schedule[pos] == ' ')pos++;
+        if(pos == length || schedule[pos] != '-')return ScheduleParseError::BadTime;
+        pos++;
+        while(pos < length && schedule[pos] == ' ')pos++;
+        if(!parse_clock(schedule, pos, end))return ScheduleParseError::BadTime;
+        if(end <= start)return ScheduleParseError::EmptyRange;
+
+        while(pos < length && schedule[pos] == ' ')pos++;
+        if(pos < length && schedule[pos] != ',')return ScheduleParseError::BadTime;
+
+        int first_slot = start / SLOT_MINUTES;
+        int end_slot = TimeGrid::slot_ceil(end);
+        while(day_bits){
+            if(!sink(ctz64(day_bits), first_slot, end_slot))return ScheduleParseError::BufferFull;
+            day_bits &= day_bits - 1;
+        }
+    }
+    return ScheduleParseError::None;
+}
+
+/**
+ * @brief Parses a schedule string straight into a weekly slot mask.
+ * @param schedule The schedule text, e.g. "TTh 10:30-12:00".
+ * @param slots Receives the slots of the schedule below WEEK_SLOTS (bits are only ever added).
+ */
+ScheduleParseError parse_schedule(std::string_view schedule, SlotMask &slots);
+
+/**
+ * @brief Parses a schedule string into a caller-provided buffer of slot indices.
+ * @param schedule The schedule text.
+ * @param slot_buffer Receives weekly slot indices in day order.
+ * @param buffer_size Capacity of slot_buffer.
+ * @param slot_count Set to the number of slots written.
+ */
+ScheduleParseError parse_schedule(std::string_view schedule, int *slot_buffer, int buffer_size, int &slot_count);
@@ -0,0 +1,73 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+#include "incremental_allocation.hpp"
+#include "lecture_allocation.hpp"
+#include "sort_order.hpp"
+
+namespace {
+
+uint64_t pair_key(uint32_t high, uint32_t low){
+    return ((uint64_t)high << 32) | low;
+}
+
+}
+
+IncrementalResult incremental_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const std::vector<PreviousAssignment> &previous, const SchedulePatternTable &schedule_patterns){
+    IncrementalResult result;
+
+    std::unordered_map<uint64_t, int> venue_of;
+    for(auto building: venues.resolve_buildings(lecture_building_priority_order)){
+        for(int venue = venues.building_ranges[building].begin; venue < venues.building_ranges[building].end; venue++){
+            venue_of[pair_key(building, venues.hall_names[venue])] = venue;
+        }
+    }
+    std::unordered_map<uint64_t, std::vector<int>> lectures_of; // by (course code, section), in input order
+    for(int lecture = 0; lecture < (int)lectures.size(); lecture++){
+        lectures_of[pair_key(lectures[lecture].course_code, lectures[lecture].section)].push_back(lecture);
+    }
+    for(auto &entry: lectures_of){
+        for(auto lecture: entry.second){
+            for(auto other: entry.second){
+                if(other != lecture && lectures[other].term_part == lectures[lecture].term_part){
+                    result.shared_keys++;
+                    break;
+                }
+            }
+        }
+    }
+
+    for(auto &line: previous){
+        auto lectures_found = lectures_of.find(pair_key(line.course_code, line.section));
+        auto venue_found = venue_of.find(pair_key(line.building, line.hall_name));
+        if(lectures_found == lectures_of.end() || venue_found == venue_of.end())continue;
+
+        int venue = venue_found->second;
+        for(auto candidate: lectures_found->second){
+            Lecture &lecture = lectures[candidate];
+            if(lecture.assignment != -1 || lecture.term_part != line.part)continue;
+            if(line.lecture_pattern != -1 && lecture.lecture_pattern != line.lecture_pattern)continue;
+            const SlotMask &slots = schedule_patterns.slots(lecture.lecture_pattern);
+            if(venues.capacities[venue] < lecture.students_registered || !venues.is_free(venue, slots))continue;
+
+            lecture.assignLectureHall(venue);
+            venues.book(venue, lecture.course_code, lecture.section, slots);
+            result.kept++;
+            break;
+        }
+    }
+
+    std::vector<int> order;
+    for(int lecture = 0; lecture < (int)lectures.size(); lecture++){
+        if(lectures[lecture].assignment == -1)order.push_back(lecture);
+    }
+    counting_sort_indices(order, [&lectures](int ind){ return lectures[ind].students_registered; });
+    result.affected = order.size();
+
+    ordered_lecture_allocation_logic(lectures, venues, lecture_building_priority_order, convenience_factor, schedule_patterns, order);
+    for(auto lecture: order){
+        if(lectures[lecture].assignment != -1)result.placed++;
+    }
+    return result;
+}
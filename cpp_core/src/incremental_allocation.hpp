@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+
+/**
+ * @brief One line of an earlier lecture schedule, by interned names
+ * (StringPool::NO_ID for names the current input no longer has).
+ */
+struct PreviousAssignment {
+    uint32_t course_code;
+    uint32_t section;
+    TermPart part;
+    int lecture_pattern; // pattern ID when the line gives its schedule, -1 otherwise
+    uint32_t building;
+    uint32_t hall_name;
+};
+
+struct IncrementalResult {
+    int kept = 0;        // lectures left in their previous hall
+    int affected = 0;    // lectures that had to be placed again
+    int placed = 0;      // affected lectures that got a hall
+    int shared_keys = 0; // lectures whose (course, section, term part) another lecture also has
+};
+
+/**
+ * @brief Re-allocates after an edit, starting from an earlier schedule.
+ * A line of the earlier schedule belongs to a lecture with its course code, section and term part,
+ * and with its schedule when the line gives one. Several lectures can share that key (repeated
+ * codes, or no sections); each line then goes to the first of them, in input order, that is still
+ * unassigned and can keep the hall.
+ * A lecture keeps its previous hall when the hall still exists in a priority building, still seats
+ * its registration count, is open in all of its slots and is not already taken by a lecture kept
+ * before it. Only the rest (lectures of removed or shrunk halls, of changed opening hours, whose size
+ * crossed the capacity, or new ones) are placed again, smallest first, by the hall rule of
+ * core_lecture_allocation_logic, so the cost follows the size of the edit rather than of the campus.
+ */
+IncrementalResult incremental_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const std::vector<PreviousAssignment> &previous, const SchedulePatternTable &schedule_patterns);
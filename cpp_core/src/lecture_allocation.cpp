@@ -1,63 +1,193 @@
-#pragma once
-
 #include <vector>
 #include <string>
-#include <map>
-#include <unordered_map>
+#include <queue>
+#include <tuple>
+#include <functional>
 #include "ds.hpp"
+#include "venue_table.hpp"
+#include "free_hall_index.hpp"
+#include "merged_hall_index.hpp"
+#include "sort_order.hpp"
+#include "schedule_pattern.hpp"
+#include "lecture_allocation.hpp"
+
+// Books the greedy's hall for a lecture in the first priority building that has one; returns the venue or -1.
+static int place_lecture(Lecture &lecture, VenueTable &venues, std::vector<FreeHallIndex> &free_halls, const std::vector<int> &priority_buildings, int convenience_factor, const SchedulePatternTable &schedule_patterns){
+    const SlotMask &lecture_slots = schedule_patterns.slots(lecture.lecture_pattern);
+    int convenient_size = (lecture.students_registered * (convenience_factor + 100))/100;
+    for(auto building: priority_buildings){
+        FreeHallIndex &halls = free_halls[building];
+
+        // First free hall at or above the convenient size, else the largest free one that still seats everyone.
+        int convenient_rank = halls.lower_bound_rank(convenient_size);
+        int rank = halls.first_free(lecture_slots, convenient_rank, halls.size());
+        if(rank == -1){
+            rank = halls.last_free(lecture_slots, halls.lower_bound_rank(lecture.students_registered), convenient_rank);
+        }
 
-bool check_availibility(std::unordered_map<int, int> &is_available, std::vector<int> &lecture_schedule){
-    for(auto time: lecture_schedule){
-        if(is_available[time] == 0)return false;
+        if(rank != -1){
+            int venue = halls.venue_at(rank);
+            lecture.assignLectureHall(venue);
+            venues.book(venue, lecture.course_code, lecture.section, lecture_slots);
+            halls.occupy(rank, lecture_slots);
+            return venue;
+        }
     }
-    return true;
+    return -1;
 }
 
-void core_lecture_allocation_logic(std::vector<Lecture> &lectures, std::map<std::string, std::vector<Venue>> &venues, std::vector<std::string> &lecture_building_priority_order, int convenience_factor){
+void core_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns){
     
-    std::sort(lectures.begin(), lectures.end(), Lecture::compareByStudents);
+    // Smallest lectures first; only the index order is sorted, the lectures stay where they are.
+    std::vector<int> order = counting_sort_order(lectures.size(), [&lectures](int ind){ return lectures[ind].students_registered; });
+
+    // Buildings without halls are dropped from the priority order once, up front.
+    std::vector<int> priority_buildings = venues.resolve_buildings(lecture_building_priority_order);
+    std::vector<FreeHallIndex> free_halls(venues.building_count());
+    for(auto building: priority_buildings){
+        free_halls[building] = FreeHallIndex(venues, building);
+    }
     
-    for(auto lecture: lectures){
-        
+    for(auto ind: order){
+        place_lecture(lectures[ind], venues, free_halls, priority_buildings, convenience_factor, schedule_patterns);
+    }
+    return;
+}
+
+void merged_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns){
+
+    std::vector<int> order = counting_sort_order(lectures.size(), [&lectures](int ind){ return lectures[ind].students_registered; });
+
+    MergedHallIndex halls(venues, venues.resolve_buildings(lecture_building_priority_order));
+
+    for(auto ind: order){
+        Lecture &lecture = lectures[ind];
+        const SlotMask &lecture_slots = schedule_patterns.slots(lecture.lecture_pattern);
         int convenient_size = (lecture.students_registered * (convenience_factor + 100))/100;
-        for(auto priority: lecture_building_priority_order){
-            auto venue = lower_bound(venues[priority].begin(), venues[priority].end(), convenient_size, [](const Venue& v, int size) {
-            return v.capacity < size;});
-
-            while(true){
-                if(venue == venues[priority].end())break;
-                
-                //check_logic if the venue can be given to the lecture
-                if(check_availibility(venue->is_available, lecture.lecture_schedule)){
-                    lecture.assignLectureHall(venue->hall_name);
-                    venue->assignLectureTutorial(lecture);
-                    break;
-                }
-                venue++;
-            }
+        int rank = halls.find(lecture_slots, lecture.students_registered, convenient_size);
+        if(rank == -1)continue;
 
-            if(lecture.assignment.empty()){
-                venue = lower_bound(venues[priority].begin(), venues[priority].end(), convenient_size, [](const Venue& v, int size) {
-            return v.capacity < size;});
-                if(venue != venues[priority].begin()){
-                    venue--;
-                    while(true){
-                        if(venue->capacity < lecture.students_registered)break;
-
-                        if(check_availibility(venue->is_available, lecture.lecture_schedule)){
-                            lecture.assignLectureHall(venue->hall_name);
-                            venue->assignLectureTutorial(lecture);
-                            break;
-                        }
-
-                        if(venue == venues[priority].begin())break;
-                        venue--;
-                    }
-                }
-            }
+        int venue = halls.venue_at(rank);
+        lecture.assignLectureHall(venue);
+        venues.book(venue, lecture.course_code, lecture.section, lecture_slots);
+        halls.occupy(rank, lecture_slots);
+    }
+    return;
+}
+
+void ordered_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns, const std::vector<int> &order){
+
+    std::vector<int> priority_buildings = venues.resolve_buildings(lecture_building_priority_order);
+    std::vector<FreeHallIndex> free_halls(venues.building_count());
+    for(auto building: priority_buildings){
+        free_halls[building] = FreeHallIndex(venues, building);
+    }
+
+    for(auto lecture: order){
+        if(lectures[lecture].assignment != -1)continue;
+        place_lecture(lectures[lecture], venues, free_halls, priority_buildings, convenience_factor, schedule_patterns);
+    }
+    return;
+}
+
+void dynamic_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns){
+
+    std::vector<int> priority_buildings = venues.resolve_buildings(lecture_building_priority_order);
+    std::vector<FreeHallIndex> free_halls(venues.building_count());
+    for(auto building: priority_buildings){
+        free_halls[building] = FreeHallIndex(venues, building);
+    }
 
-            if(!lecture.assignment.empty())break;
+    int lecture_count = lectures.size();
+    std::vector<int> free_count(lecture_count, 0);
+    std::vector<std::vector<int>> slot_lectures(TERM_SLOTS);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        const SlotMask &slots = schedule_patterns.slots(lectures[lecture].lecture_pattern);
+        slots.for_each_slot([&](int slot){
+            slot_lectures[slot].push_back(lecture);
+        });
+        for(auto building: priority_buildings){
+            FreeHallIndex &halls = free_halls[building];
+            free_count[lecture] += halls.count_free(slots, halls.lower_bound_rank(lectures[lecture].students_registered), halls.size());
         }
     }
+
+    // Fewest free halls first, larger lectures first on ties; entries whose count is stale are skipped.
+    using Entry = std::tuple<int, int, int>; // (free halls, -students, lecture)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        queue.push({free_count[lecture], -lectures[lecture].students_registered, lecture});
+    }
+
+    std::vector<char> done(lecture_count, 0);
+    std::vector<int> seen(lecture_count, -1);
+    while(!queue.empty()){
+        auto [count, negative_students, lecture] = queue.top();
+        queue.pop();
+        if(done[lecture] || count != free_count[lecture])continue;
+        done[lecture] = 1;
+
+        const SlotMask &slots = schedule_patterns.slots(lectures[lecture].lecture_pattern);
+        int venue = place_lecture(lectures[lecture], venues, free_halls, priority_buildings, convenience_factor, schedule_patterns);
+        if(venue == -1)continue;
+
+        // The hall just taken drops out of the count of every open lecture it could have seated in these slots.
+        int building = venues.building_ids[venue];
+        FreeHallIndex &halls = free_halls[building];
+        int rank = venue - venues.building_ranges[building].begin;
+        slots.for_each_slot([&](int slot){
+            for(auto other: slot_lectures[slot]){
+                if(done[other] || seen[other] == lecture)continue;
+                seen[other] = lecture;
+                if(venues.capacities[venue] < lectures[other].students_registered)continue;
+
+                const SlotMask &other_slots = schedule_patterns.slots(lectures[other].lecture_pattern);
+                SlotMask outside = other_slots;
+                outside.remove(slots);
+                if(!halls.is_free(rank, outside))continue;
+                free_count[other]--;
+                queue.push({free_count[other], -lectures[other].students_registered, other});
+            }
+        });
+    }
     return;
-}
\ No newline at end of file
+}
+
+AllocationStats allocation_stats(const std::vector<Lecture> &lectures, const VenueTable &venues){
+    AllocationStats stats;
+    for(auto &lecture: lectures){
+        if(lecture.assignment == -1){
+            stats.unassigned++;
+            continue;
+        }
+        stats.wasted_seats += venues.capacities[lecture.assignment] - lecture.students_registered;
+    }
+    return stats;
+}
+
+AllocationTable allocation_table(const std::vector<Lecture> &lectures, const VenueTable &venues, int convenience_factor){
+    AllocationTable table;
+    table.venues.resize(lectures.size());
+    table.status.resize(lectures.size());
+    for(size_t ind = 0; ind < lectures.size(); ind++){
+        const Lecture &lecture = lectures[ind];
+        table.venues[ind] = lecture.assignment;
+        if(lecture.assignment == -1){
+            table.status[ind] = PlacementStatus::Unplaced;
+            continue;
+        }
+        int convenient_size = (lecture.students_registered * (convenience_factor + 100))/100;
+        table.status[ind] = venues.capacities[lecture.assignment] >= convenient_size ? PlacementStatus::Placed : PlacementStatus::PlacedBelowConvenient;
+    }
+    return table;
+}
+
+const char *placement_status_name(PlacementStatus status){
+    switch(status){
+        case PlacementStatus::Placed: return "placed";
+        case PlacementStatus::PlacedBelowConvenient: return "placedBelowConvenient";
+        case PlacementStatus::NoSchedule: return "noSchedule";
+        case PlacementStatus::InvalidSchedule: return "invalidSchedule";
+        default: return "unplaced";
+    }
+}
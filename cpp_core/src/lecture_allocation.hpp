@@ -2,7 +2,61 @@
 
 #include <vector>
 #include <string>
-#include <map>
+#include <cstdint>
 #include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
 
-void core_lecture_allocation_logic(std::vector<Lecture> &lectures, std::map<std::string, std::vector<Venue>> &venues, std::vector<std::string> &lecture_building_priority_order, int convenience_factor);
\ No newline at end of file
+/**
+ * @brief Quality of an assignment, in the order the allocators optimise it.
+ */
+struct AllocationStats {
+    int unassigned = 0;
+    long long wasted_seats = 0; // sum of capacity - students over assigned lectures
+};
+
+enum class PlacementStatus : uint8_t {
+    Unplaced,
+    Placed,                // in a hall of at least the convenient size
+    PlacedBelowConvenient, // seats everyone, but without the convenience headroom
+    NoSchedule,            // kept out of allocation: the course gives no lecture schedule
+    InvalidSchedule        // kept out of allocation: the lecture schedule does not parse
+};
+
+/**
+ * @brief Dense result of a lecture allocation, indexed like the lecture vector.
+ */
+struct AllocationTable {
+    std::vector<int> venues; // venue ID per lecture, -1 when unplaced
+    std::vector<PlacementStatus> status;
+};
+
+void core_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns);
+
+/**
+ * @brief Same assignment as core_lecture_allocation_logic, searched in one pass over all priority
+ * buildings with a MergedHallIndex instead of one building after the other.
+ */
+void merged_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns);
+
+/**
+ * @brief Places the still unassigned lectures in the given order of indices, with the hall rule of
+ * core_lecture_allocation_logic. The vector itself is not reordered.
+ */
+void ordered_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns, const std::vector<int> &order);
+
+/**
+ * @brief Greedy allocation in most-constrained-first order.
+ * Every unplaced lecture keeps the number of free halls that seat it in the priority buildings,
+ * counted with popcounts over the free-hall bitsets. The lecture with the fewest is placed next (by
+ * the same hall rule as core_lecture_allocation_logic), and only lectures sharing a slot with it
+ * have their count updated. Lectures keep their order in the vector.
+ */
+void dynamic_lecture_allocation_logic(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns);
+
+AllocationStats allocation_stats(const std::vector<Lecture> &lectures, const VenueTable &venues);
+
+// Fills the result table for the lectures' current assignments in one pass.
+AllocationTable allocation_table(const std::vector<Lecture> &lectures, const VenueTable &venues, int convenience_factor);
+
+const char *placement_status_name(PlacementStatus status);
@@ -0,0 +1,391 @@
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+#include "local_search.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+/**
+ * The instance as seen by every chain: lecture sizes and slots, the halls each lecture fits in,
+ * and per hall the bookings that were not made for these lectures.
+ */
+struct SearchProblem {
+    const VenueTable &venues;
+    std::vector<int> sizes;
+    std::vector<SlotMask> masks;
+    std::vector<std::vector<int>> candidates;
+    std::vector<int> group_of;             // lectures with identical slots share a group
+    std::vector<std::vector<int>> groups;
+    std::vector<char> allowed;             // per venue: in a priority building
+    std::vector<SlotMask> others;          // per venue
+    std::vector<int> start;                // venue per lecture before the pass
+    long long unassigned_penalty = 1;      // above any single hall's waste
+
+    explicit SearchProblem(const VenueTable &venues) : venues(venues) {}
+
+    bool fits(int lecture, int venue) const {
+        return allowed[venue] && venues.capacities[venue] >= sizes[lecture]
+            && venues.opening_templates[venues.opening_ids[venue]].contains(masks[lecture])
+            && !others[venue].intersects(masks[lecture]);
+    }
+
+    long long cost(int lecture, int venue) const {
+        return venue == -1 ? unassigned_penalty : venues.capacities[venue] - sizes[lecture];
+    }
+};
+
+/**
+ * One cooling schedule, possibly run in several slices. The temperature falls over `iterations`
+ * moves of the chain, or over [started, deadline] when `iterations` is 0; a timed schedule also
+ * stops at the deadline.
+ */
+struct Cooling {
+    long long iterations = 0;
+    bool timed = false;
+    std::chrono::steady_clock::time_point started;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+class Chain {
+public:
+    std::vector<int> best;
+    int best_unassigned = 0;
+    long long best_waste = 0;
+    long long tried = 0;
+    long long accepted = 0;
+
+    Chain(const SearchProblem &problem, uint64_t seed);
+
+    // Continues the schedule from where the chain's earlier moves left it for up to `moves` moves
+    // (0: until the schedule ends); returns true when the best assignment improved.
+    bool run(const Cooling &cooling, long long moves);
+
+private:
+    const SearchProblem &problem;
+    std::mt19937_64 rng;
+    std::vector<int> hall;
+    std::vector<SlotMask> occupied;
+    std::vector<std::vector<int>> on_venue;
+    int unassigned = 0;
+    long long waste = 0;
+    double temperature = 1;
+
+    int pick(int count){ return (int)(rng() % (uint64_t)count); }
+
+    bool accept(long long delta){
+        if(delta <= 0)return true;
+        double draw = (rng() >> 11) * 0x1.0p-53;
+        return draw < std::exp(-(double)delta / temperature);
+    }
+
+    void place(int lecture, int venue);
+    void lift(int lecture);
+
+    // Each returns true when the move applied; all of them leave the state untouched otherwise.
+    bool relocate(int lecture);
+    bool eject(int lecture);
+    bool pattern_swap(int lecture);
+};
+
+Chain::Chain(const SearchProblem &problem, uint64_t seed) : problem(problem), rng(seed) {
+    int lecture_count = problem.sizes.size();
+    hall.assign(lecture_count, -1);
+    occupied = problem.others;
+    on_venue.resize(problem.venues.size());
+    for(int lecture = 0; lecture < lecture_count; lecture++)place(lecture, problem.start[lecture]);
+
+    best = hall;
+    best_unassigned = unassigned;
+    best_waste = waste;
+}
+
+void Chain::place(int lecture, int venue){
+    hall[lecture] = venue;
+    if(venue == -1){
+        unassigned++;
+        return;
+    }
+    waste += problem.cost(lecture, venue);
+    occupied[venue] |= problem.masks[lecture];
+    on_venue[venue].push_back(lecture);
+}
+
+void Chain::lift(int lecture){
+    int venue = hall[lecture];
+    if(venue == -1){
+        unassigned--;
+        return;
+    }
+    waste -= problem.cost(lecture, venue);
+    occupied[venue].remove(problem.masks[lecture]);
+    std::vector<int> &holders = on_venue[venue];
+    *std::find(holders.begin(), holders.end(), lecture) = holders.back();
+    holders.pop_back();
+}
+
+bool Chain::relocate(int lecture){
+    const std::vector<int> &candidates = problem.candidates[lecture];
+    if(candidates.empty())return false;
+    int target = candidates[pick(candidates.size())];
+    if(target == hall[lecture] || occupied[target].intersects(problem.masks[lecture]))return false;
+
+    if(!accept(problem.cost(lecture, target) - problem.cost(lecture, hall[lecture])))return false;
+    lift(lecture);
+    place(lecture, target);
+    return true;
+}
+
+bool Chain::eject(int lecture){
+    const std::vector<int> &candidates = problem.candidates[lecture];
+    if(candidates.empty())return false;
+    int target = candidates[pick(candidates.size())];
+    int current = hall[lecture];
+    if(target == current)return false;
+
+    // Only a single lecture in the way can be exchanged.
+    int blocker = -1;
+    for(auto other: on_venue[target]){
+        if(!problem.masks[other].intersects(problem.masks[lecture]))continue;
+        if(blocker != -1)return false;
+        blocker = other;
+    }
+    if(blocker == -1)return false;
+
+    if(current != -1){
+        if(!problem.fits(blocker, current))return false;
+        SlotMask rest = occupied[current];
+        rest.remove(problem.masks[lecture]);
+        if(rest.intersects(problem.masks[blocker]))return false;
+    }
+
+    long long delta = problem.cost(lecture, target) + problem.cost(blocker, current) - problem.cost(lecture, current) - problem.cost(blocker, target);
+    if(!accept(delta))return false;
+    lift(lecture);
+    lift(blocker);
+    place(lecture, target);
+    place(blocker, current);
+    return true;
+}
+
+bool Chain::pattern_swap(int lecture){
+    const std::vector<int> &group = problem.groups[problem.group_of[lecture]];
+    if(group.size() < 2)return false;
+    int other = group[pick(group.size())];
+    int mine = hall[lecture];
+    int theirs = hall[other];
+    if(mine == theirs)return false;
+
+    // Same slots, so only the capacities can get in the way.
+    if(theirs != -1 && problem.venues.capacities[theirs] < problem.sizes[lecture])return false;
+    if(mine != -1 && problem.venues.capacities[mine] < problem.sizes[other])return false;
+
+    long long delta = problem.cost(lecture, theirs) + problem.cost(other, mine) - problem.cost(lecture, mine) - problem.cost(other, theirs);
+    if(!accept(delta))return false;
+    lift(lecture);
+    lift(other);
+    place(lecture, theirs);
+    place(other, mine);
+    return true;
+}
+
+bool Chain::run(const Cooling &cooling, long long moves){
+    int lecture_count = hall.size();
+    if(lecture_count == 0)return false;
+    bool improved = false;
+
+    long long total_size = 0;
+    for(auto size: problem.sizes)total_size += size;
+    const double start_temperature = 1.0 + 0.1 * total_size / lecture_count;
+    const double end_temperature = 0.05;
+    const double span = std::max(1.0, std::chrono::duration<double, std::milli>(cooling.deadline - cooling.started).count());
+
+    double progress = 0;
+    for(long long move = 0; moves == 0 || move < moves; move++){
+        // The clock is read once per 256 moves; a timed schedule cools in those steps.
+        if(cooling.timed && (move & 255) == 0){
+            auto now = std::chrono::steady_clock::now();
+            if(now >= cooling.deadline)break;
+            if(cooling.iterations == 0)progress = std::chrono::duration<double, std::milli>(now - cooling.started).count() / span;
+        }
+        if(cooling.iterations > 0)progress = (double)tried / cooling.iterations;
+        if(progress >= 1)break;
+        temperature = start_temperature * std::pow(end_temperature / start_temperature, progress);
+
+        int lecture = pick(lecture_count);
+        bool moved;
+        switch(rng() % 3){
+            case 0: moved = relocate(lecture); break;
+            case 1: moved = eject(lecture); break;
+            default: moved = pattern_swap(lecture); break;
+        }
+        tried++;
+        if(!moved)continue;
+        accepted++;
+
+        if(unassigned < best_unassigned || (unassigned == best_unassigned && waste < best_waste)){
+            best = hall;
+            best_unassigned = unassigned;
+            best_waste = waste;
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+// splitmix64, so chains seeded with consecutive values start far apart.
+uint64_t chain_seed(uint64_t seed, int chain){
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull * (uint64_t)(chain + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Fills in the instance for the lectures' current assignment and returns it.
+SearchProblem &build_problem(SearchProblem &problem, const std::vector<Lecture> &lectures, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns){
+    const VenueTable &venues = problem.venues;
+    int lecture_count = lectures.size();
+    problem.allowed.assign(venues.size(), 0);
+    int largest_capacity = 0;
+    for(auto building: venues.resolve_buildings(lecture_building_priority_order)){
+        for(int venue = venues.building_ranges[building].begin; venue < venues.building_ranges[building].end; venue++){
+            problem.allowed[venue] = 1;
+            largest_capacity = std::max(largest_capacity, venues.capacities[venue]);
+        }
+    }
+    problem.unassigned_penalty = largest_capacity + 1;
+
+    problem.others = venues.booked;
+    std::unordered_map<SlotMask, int> group_ids;
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        problem.sizes.push_back(lectures[lecture].students_registered);
+        problem.masks.push_back(schedule_patterns.slots(lectures[lecture].lecture_pattern));
+        problem.start.push_back(lectures[lecture].assignment);
+        if(lectures[lecture].assignment != -1){
+            problem.others[lectures[lecture].assignment].remove(problem.masks.back());
+        }
+
+        auto found = group_ids.emplace(problem.masks.back(), (int)problem.groups.size());
+        if(found.second)problem.groups.emplace_back();
+        problem.groups[found.first->second].push_back(lecture);
+        problem.group_of.push_back(found.first->second);
+    }
+
+    problem.candidates.resize(lecture_count);
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        for(int venue = 0; venue < venues.size(); venue++){
+            if(problem.fits(lecture, venue))problem.candidates[lecture].push_back(venue);
+        }
+    }
+    return problem;
+}
+
+// Moves the lectures whose hall differs in `best` from the start of the problem.
+void write_back(const SearchProblem &problem, const std::vector<int> &best, std::vector<Lecture> &lectures, VenueTable &venues){
+    int lecture_count = lectures.size();
+
+    // Release every moved lecture before booking again, so no new booking is cleared by a release.
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        if(best[lecture] == problem.start[lecture] || problem.start[lecture] == -1)continue;
+        venues.unbook(problem.start[lecture], lectures[lecture].course_code, lectures[lecture].section, problem.masks[lecture]);
+    }
+    for(int lecture = 0; lecture < lecture_count; lecture++){
+        if(best[lecture] == problem.start[lecture])continue;
+        if(best[lecture] == -1){
+            lectures[lecture].unassignLectureHall();
+            continue;
+        }
+        lectures[lecture].assignLectureHall(best[lecture]);
+        venues.book(best[lecture], lectures[lecture].course_code, lectures[lecture].section, problem.masks[lecture]);
+    }
+}
+
+}
+
+LocalSearchResult improve_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, const LocalSearchOptions &options){
+    LocalSearchResult result;
+    result.before = allocation_stats(lectures, venues);
+    result.after = result.before;
+    if(options.time_budget_ms <= 0 && options.iterations <= 0)return result;
+
+    SearchProblem problem(venues);
+    build_problem(problem, lectures, lecture_building_priority_order, schedule_patterns);
+
+    int chain_count = options.chains > 0 ? options.chains : ThreadPool::default_threads();
+    std::vector<Chain> chains;
+    chains.reserve(chain_count);
+    for(int chain = 0; chain < chain_count; chain++)chains.emplace_back(problem, chain_seed(options.seed, chain));
+
+    Cooling cooling;
+    cooling.iterations = options.iterations;
+    cooling.timed = options.time_budget_ms > 0;
+    cooling.started = std::chrono::steady_clock::now();
+    cooling.deadline = cooling.started + std::chrono::milliseconds(std::max(0, options.time_budget_ms));
+    if(chain_count == 1){
+        chains[0].run(cooling, 0);
+    }
+    else{
+        ThreadPool pool(chain_count);
+        for(auto &chain: chains){
+            pool.submit([&chain, &cooling]{ chain.run(cooling, 0); });
+        }
+        pool.wait();
+    }
+
+    int best_unassigned = result.before.unassigned;
+    long long best_waste = result.before.wasted_seats;
+    for(int chain = 0; chain < chain_count; chain++){
+        result.moves_tried += chains[chain].tried;
+        result.moves_accepted += chains[chain].accepted;
+        if(chains[chain].best_unassigned < best_unassigned || (chains[chain].best_unassigned == best_unassigned && chains[chain].best_waste < best_waste)){
+            best_unassigned = chains[chain].best_unassigned;
+            best_waste = chains[chain].best_waste;
+            result.best_chain = chain;
+        }
+    }
+    if(result.best_chain == -1)return result;
+
+    write_back(problem, chains[result.best_chain].best, lectures, venues);
+    result.after = allocation_stats(lectures, venues);
+    return result;
+}
+
+struct AnnealingRun::State {
+    SearchProblem problem;
+    Chain chain;
+    Cooling cooling;       // timed, from the first step to the latest deadline
+    bool stepped = false;
+
+    State(const std::vector<Lecture> &lectures, const VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, uint64_t seed)
+        : problem(venues), chain(build_problem(problem, lectures, lecture_building_priority_order, schedule_patterns), chain_seed(seed, 0)) {}
+};
+
+AnnealingRun::AnnealingRun(const std::vector<Lecture> &lectures, const VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, uint64_t seed)
+    : state(std::make_unique<State>(lectures, venues, lecture_building_priority_order, schedule_patterns, seed)) {}
+
+AnnealingRun::~AnnealingRun() = default;
+
+bool AnnealingRun::step(long long iterations, std::chrono::steady_clock::time_point deadline){
+    if(iterations <= 0)return false;
+    if(!state->stepped){
+        state->cooling.timed = true;
+        state->cooling.started = std::chrono::steady_clock::now();
+        state->stepped = true;
+    }
+    state->cooling.deadline = deadline;
+    return state->chain.run(state->cooling, iterations);
+}
+
+AllocationStats AnnealingRun::best() const {
+    AllocationStats stats;
+    stats.unassigned = state->chain.best_unassigned;
+    stats.wasted_seats = state->chain.best_waste;
+    return stats;
+}
+
+void AnnealingRun::commit(std::vector<Lecture> &lectures, VenueTable &venues) const {
+    write_back(state->problem, state->chain.best, lectures, venues);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+#include "lecture_allocation.hpp"
+
+/**
+ * @brief Settings of the improvement pass. The pass runs until the time budget or the iteration
+ * limit per chain is used up; with an iteration limit the temperature follows the iterations, so
+ * a given seed reproduces the same result.
+ */
+struct LocalSearchOptions {
+    int time_budget_ms = 0;  // 0: no wall-clock limit
+    long long iterations = 0; // moves tried per chain, 0: no iteration limit
+    uint64_t seed = 1;
+    int chains = 0;          // independent chains, ThreadPool::default_threads() when <= 0
+};
+
+struct LocalSearchResult {
+    AllocationStats before;
+    AllocationStats after;
+    long long moves_tried = 0;    // over all chains
+    long long moves_accepted = 0;
+    int best_chain = -1;          // chain whose result was kept, -1 when none improved
+};
+
+/**
+ * @brief Improves an existing lecture assignment by simulated annealing.
+ * Moves relocate a lecture to another hall, exchange two lectures' halls when one is in the
+ * other's way, or exchange the halls of two lectures with the same slots. Each move is checked
+ * and priced against per-hall occupancy masks only, so it costs O(slots / 64). The cost is the
+ * wasted seats plus a penalty above any hall's capacity per unassigned lecture. Chains run on a
+ * thread pool from the same start, each with its own seeded RNG; the best (fewest unassigned,
+ * then least waste, then lowest chain) is written back when it beats the start.
+ * Only halls of the priority buildings are used.
+ */
+LocalSearchResult improve_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, const LocalSearchOptions &options);
+
+
+/**
+ * @class AnnealingRun
+ * @brief One annealing chain over the lectures' current assignment, advanced in slices on the
+ * calling thread. The instance (candidate halls, slot groups, other bookings) is built once, and
+ * the chain keeps its state and RNG from one slice to the next. The slices share one cooling
+ * schedule, which runs from the first step() to the deadline, so the temperature keeps falling
+ * across slices instead of starting hot again in each one. The lectures and venue table it was built from must not change until commit().
+ */
+class AnnealingRun {
+public:
+    AnnealingRun(const std::vector<Lecture> &lectures, const VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns, uint64_t seed);
+    ~AnnealingRun();
+
+    // Tries up to `iterations` more moves, stopping at the deadline; true when the best assignment improved.
+    bool step(long long iterations, std::chrono::steady_clock::time_point deadline);
+
+    AllocationStats best() const;
+
+    // Writes the best assignment found into the lectures and venue table the run was built from.
+    void commit(std::vector<Lecture> &lectures, VenueTable &venues) const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
@@ -1,7 +1,18 @@
 #include <iostream>
 #include <string>
-#include <io.h>      // for _dup2, _close
+#include <charconv>
 #include <fcntl.h>   // for _open
+#ifdef _WIN32
+#include <io.h>      // for _dup2, _close
+#else
+#include <unistd.h>  // dup2, close and open under their POSIX names
+#define _open open
+#define _dup2 dup2
+#define _close close
+#define _O_WRONLY O_WRONLY
+#define _O_CREAT O_CREAT
+#define _O_TRUNC O_TRUNC
+#endif
 #include <cstdlib>
 #include "../helpers/json.hpp" // Make sure this path is correct
 #include "ds.hpp"
@@ -9,11 +20,36 @@
 #include "course_processing.hpp"
 #include "venue_processing.hpp"
 #include "lecture_allocation.hpp"
+#include "exact_allocation.hpp"
+#include "pattern_matching.hpp"
+#include "component_allocation.hpp"
+#include "local_search.hpp"
+#include "ejection_repair.hpp"
+#include "convenience_sweep.hpp"
+#include "convenience_tuning.hpp"
+#include "portfolio_allocation.hpp"
+#include "incremental_allocation.hpp"
 #include "tutorial_allocation.hpp"
 
 // for convenience
 using json = nlohmann::json;
 
+// Reads an integer setting given either as a number or as a numeric string; `fallback` when the
+// setting is absent or the string is not a whole integer (e.g. "auto").
+static int json_int(const json &j, const char *key, int fallback){
+    if(!j.contains(key))return fallback;
+    const json &value = j.at(key);
+    if(value.is_number_integer())return value.get<int>();
+    if(value.is_string()){
+        const std::string &text = value.get_ref<const std::string&>();
+        int parsed = 0;
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+        if(ec != std::errc() || end != text.data() + text.size())return fallback;
+        return parsed;
+    }
+    return fallback;
+}
+
 int main() {
     // The C++ program will now wait for input from stdin
     // instead of looking for a file argument.
@@ -38,46 +74,375 @@ int main() {
     std::cout << j.dump(4);
 
     std::vector<Course> preprocessed_course_list; 
-    std::map<std::string, std::vector<Venue>> processed_venue_list;
+    VenueTable processed_venue_list;
     std::vector<Lecture>  processed_lecture_lists;
     std::vector<Tutorial> processed_tutorial_lists;
-    std::vector<std::string> lecture_building_priority_order;
-    std::vector<std::string> tutorial_building_priority_order;
+    std::vector<uint32_t> lecture_building_priority_order;
+    std::vector<uint32_t> tutorial_building_priority_order;
     int convenience_factor = 0;
+    SchedulePatternTable schedule_patterns;
+    NamePools names;
 
     if(j.contains("courseData") && j.at("courseData").is_array()){
-        preprocessed_course_list = course_preprocessing_function(j.at("courseData").get<std::vector<json>>());    
+        preprocessed_course_list = course_preprocessing_function(j.at("courseData").get<std::vector<json>>(), schedule_patterns, names);    
     }
 
     if(j.contains("hallData") && j.at("hallData").is_array()){
-        processed_venue_list = venue_processing(j.at("hallData").get<std::vector<json>>());
+        processed_venue_list = venue_processing(j.at("hallData").get<std::vector<json>>(), names);
     }
 
-    std::tie(processed_lecture_lists, processed_tutorial_lists) = course_processing(preprocessed_course_list);
+    // A lecture whose schedule gives no slots would fit in every hall, so lectures without a schedule
+    // or with one that does not parse stay out of allocation and are reported as such.
+    std::vector<Lecture> lecture_rows;
+    std::tie(lecture_rows, processed_tutorial_lists) = course_processing(preprocessed_course_list);
+    std::vector<int> allocated_index(lecture_rows.size(), -1); // per row, index into processed_lecture_lists
+    int invalid_schedules = 0;
+    int missing_schedules = 0;
+    for(size_t row = 0; row < lecture_rows.size(); row++){
+        int pattern = lecture_rows[row].lecture_pattern;
+        if(schedule_patterns.slots(pattern).none()){
+            if(schedule_patterns.error(pattern) != ScheduleParseError::None)invalid_schedules++;
+            else missing_schedules++;
+            continue;
+        }
+        allocated_index[row] = processed_lecture_lists.size();
+        processed_lecture_lists.push_back(lecture_rows[row]);
+    }
 
     if(j.contains("lectureBuildingPriorities") && j.at("lectureBuildingPriorities").is_array()){
-        lecture_building_priority_order = j.at("lectureBuildingPriorities").get<std::vector<std::string>>();
+        // Names of buildings without halls resolve to StringPool::NO_ID and are skipped by the allocator.
+        for(auto &building: j.at("lectureBuildingPriorities")){
+            lecture_building_priority_order.push_back(names.buildings.find(building.get_ref<const std::string&>()));
+        }
     }
 
     if(j.contains("tutorialBuildingPriorities") && j.at("tutorialBuildingPriorities").is_array()){
-        tutorial_building_priority_order = j.at("tutorialBuildingPriorities").get<std::vector<std::string>>();
+        for(auto &building: j.at("tutorialBuildingPriorities")){
+            tutorial_building_priority_order.push_back(names.buildings.find(building.get_ref<const std::string&>()));
+        }
+    }
+
+    convenience_factor = json_int(j, "convenienceFactor", convenience_factor);
+    // Headroom the lectures' placement status is judged by; autotune replaces it with the tuned one.
+    int lecture_convenience_factor = convenience_factor;
+
+    // "convenienceSweep": {"from", "to", "step"} also runs the greedy for every factor in the range
+    // on the untouched model and reports each result and the Pareto-optimal ones.
+    json sweep_output;
+    if(j.contains("convenienceSweep") && j.at("convenienceSweep").is_object()){
+        const json &sweep = j.at("convenienceSweep");
+        int from = json_int(sweep, "from", 0);
+        int to = json_int(sweep, "to", 100);
+        int step = std::max(1, json_int(sweep, "step", 10));
+        std::vector<int> factors;
+        for(int factor = from; factor <= to; factor += step)factors.push_back(factor);
+
+        sweep_output = json::array();
+        for(auto &point: convenience_factor_sweep(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, factors, schedule_patterns, json_int(j, "threads", 0))){
+            sweep_output.push_back({
+                {"convenienceFactor", point.convenience_factor},
+                {"unassigned", point.stats.unassigned},
+                {"wastedSeats", point.stats.wasted_seats},
+                {"priorityHitRate", point.priority_hit_rate},
+                {"pareto", point.pareto}
+            });
+        }
+    }
+
+    // "exact" runs the branch-and-bound solver and reports how the greedy does on the same input;
+    // "matching" solves each schedule pattern class as a min-cost matching; "autotune" looks for the
+    // largest factor in ["autoTuneFrom", "autoTuneTo"] that still seats every lecture with that
+    // headroom, falling back to the greedy when even the lowest one does not; "dynamic" places the
+    // lecture with the fewest free halls next; "portfolio" races several strategies for
+    // "portfolioTimeMs" and keeps the best; "incremental" keeps what it can of
+    // "previousLectureSchedule" and places only the lectures the edit affected; "merged" is the greedy
+    // searched over all priority buildings in one pass.
+    std::string allocation_mode = "greedy";
+    if(j.contains("allocationMode") && j.at("allocationMode").is_string()){
+        allocation_mode = j.at("allocationMode").get<std::string>();
+    }
+
+    ExactAllocationLimits limits;
+    limits.node_limit = json_int(j, "exactNodeLimit", (int)limits.node_limit);
+    limits.time_limit_ms = json_int(j, "exactTimeLimitMs", limits.time_limit_ms);
+
+    // "splitComponents" runs the chosen allocator on every group of lectures that share no slot
+    // with the rest, on "threads" workers; exact limits then apply per component. Only "exact",
+    // "matching", "merged" and "dynamic" run per component; any other mode runs the greedy there,
+    // and the summary gives the mode that ran next to "requestedMode".
+    bool split_components = j.contains("splitComponents") && j.at("splitComponents").is_boolean() && j.at("splitComponents").get<bool>();
+
+    json allocation_summary;
+    if(split_components){
+        std::string component_mode = allocation_mode == "exact" || allocation_mode == "matching" || allocation_mode == "merged" || allocation_mode == "dynamic" ? allocation_mode : "greedy";
+        ComponentSolver solver = [&](std::vector<Lecture> &lectures, VenueTable &venues){
+            if(component_mode == "exact")exact_lecture_allocation(lectures, venues, lecture_building_priority_order, schedule_patterns, limits);
+            else if(component_mode == "matching")pattern_matching_allocation(lectures, venues, lecture_building_priority_order, schedule_patterns);
+            else if(component_mode == "merged")merged_lecture_allocation_logic(lectures, venues, lecture_building_priority_order, convenience_factor, schedule_patterns);
+            else if(component_mode == "dynamic")dynamic_lecture_allocation_logic(lectures, venues, lecture_building_priority_order, convenience_factor, schedule_patterns);
+            else core_lecture_allocation_logic(lectures, venues, lecture_building_priority_order, convenience_factor, schedule_patterns);
+        };
+        ComponentAllocationResult split = component_allocation(processed_lecture_lists, processed_venue_list, schedule_patterns, solver, json_int(j, "threads", 0));
+        AllocationStats stats = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", component_mode},
+            {"components", split.components},
+            {"largestComponent", split.largest_component},
+            {"unassigned", stats.unassigned},
+            {"wastedSeats", stats.wasted_seats}
+        };
+        if(component_mode != allocation_mode)allocation_summary["requestedMode"] = allocation_mode;
+    }
+    else if(allocation_mode == "exact"){
+        std::vector<Lecture> greedy_lectures = processed_lecture_lists;
+        VenueTable greedy_venues = processed_venue_list;
+        core_lecture_allocation_logic(greedy_lectures, greedy_venues, lecture_building_priority_order, convenience_factor, schedule_patterns);
+        AllocationStats greedy = allocation_stats(greedy_lectures, greedy_venues);
+
+        ExactAllocationResult exact = exact_lecture_allocation(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, schedule_patterns, limits);
+        allocation_summary = {
+            {"mode", "exact"},
+            {"unassigned", exact.unassigned},
+            {"wastedSeats", exact.wasted_seats},
+            {"nodes", exact.nodes},
+            {"optimal", exact.optimal},
+            {"greedyUnassigned", greedy.unassigned},
+            {"greedyWastedSeats", greedy.wasted_seats}
+        };
+    }
+    else if(allocation_mode == "matching"){
+        PatternMatchingResult matching = pattern_matching_allocation(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, schedule_patterns);
+        AllocationStats stats = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", "matching"},
+            {"unassigned", stats.unassigned},
+            {"wastedSeats", stats.wasted_seats},
+            {"patternClasses", matching.pattern_classes},
+            {"overlappingClasses", matching.overlapping_classes},
+            {"optimal", matching.optimal}
+        };
+    }
+    else if(allocation_mode == "autotune"){
+        ConvenienceTuningResult tuning = tune_convenience_factor(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, json_int(j, "autoTuneFrom", 0), json_int(j, "autoTuneTo", 100), schedule_patterns);
+        if(!tuning.feasible){
+            core_lecture_allocation_logic(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor, schedule_patterns);
+        }
+        else lecture_convenience_factor = tuning.convenience_factor;
+        AllocationStats stats = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", "autotune"},
+            {"feasible", tuning.feasible},
+            {"tunedConvenienceFactor", tuning.convenience_factor},
+            {"probes", tuning.probes},
+            {"lecturesMoved", tuning.lectures_moved},
+            {"unassigned", stats.unassigned},
+            {"wastedSeats", stats.wasted_seats}
+        };
+    }
+    else if(allocation_mode == "dynamic"){
+        dynamic_lecture_allocation_logic(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor, schedule_patterns);
+        AllocationStats stats = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", "dynamic"},
+            {"unassigned", stats.unassigned},
+            {"wastedSeats", stats.wasted_seats}
+        };
+    }
+    else if(allocation_mode == "portfolio"){
+        PortfolioOptions portfolio_options;
+        portfolio_options.time_budget_ms = json_int(j, "portfolioTimeMs", portfolio_options.time_budget_ms);
+        portfolio_options.threads = json_int(j, "threads", 0);
+        portfolio_options.seed = json_int(j, "portfolioSeed", (int)portfolio_options.seed);
+        PortfolioResult portfolio = portfolio_lecture_allocation(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor, schedule_patterns, portfolio_options);
+
+        json runs = json::array();
+        for(auto &run: portfolio.runs){
+            runs.push_back({
+                {"strategy", run.strategy},
+                {"unassigned", run.stats.unassigned},
+                {"wastedSeats", run.stats.wasted_seats},
+                {"stoppedEarly", run.stopped_early}
+            });
+        }
+        allocation_summary = {
+            {"mode", "portfolio"},
+            {"winner", portfolio.runs[portfolio.winner].strategy},
+            {"unassigned", portfolio.runs[portfolio.winner].stats.unassigned},
+            {"wastedSeats", portfolio.runs[portfolio.winner].stats.wasted_seats},
+            {"runs", runs}
+        };
+    }
+    else if(allocation_mode == "incremental"){
+        // Lines use the lectureSchedule keys; names missing from this input resolve to StringPool::NO_ID.
+        // "Lecture Schedule", when given, tells apart lectures with the same code and section.
+        std::vector<PreviousAssignment> previous;
+        if(j.contains("previousLectureSchedule") && j.at("previousLectureSchedule").is_array()){
+            for(auto &line: j.at("previousLectureSchedule")){
+                if(!line.contains("Course Code") || !line.contains("Building") || !line.contains("Lecture Hall Assigned"))continue;
+                if(!line.at("Lecture Hall Assigned").is_string())continue;
+                std::string section = line.contains("Section") ? line.at("Section").get<std::string>() : "";
+                TermPart part = course_term_part(line);
+                int lecture_pattern = -1;
+                if(line.contains("Lecture Schedule") && line.at("Lecture Schedule").is_string()){
+                    // A schedule this input never uses matches no lecture.
+                    lecture_pattern = schedule_patterns.find(line.at("Lecture Schedule").get_ref<const std::string&>(), part);
+                    if(lecture_pattern == -1)continue;
+                }
+                previous.push_back({
+                    names.course_codes.find(line.at("Course Code").get_ref<const std::string&>()),
+                    names.sections.find(section),
+                    part,
+                    lecture_pattern,
+                    names.buildings.find(line.at("Building").get_ref<const std::string&>()),
+                    names.halls.find(line.at("Lecture Hall Assigned").get_ref<const std::string&>())
+                });
+            }
+        }
+
+        IncrementalResult incremental = incremental_lecture_allocation(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor, previous, schedule_patterns);
+        AllocationStats stats = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", "incremental"},
+            {"kept", incremental.kept},
+            {"affected", incremental.affected},
+            {"placed", incremental.placed},
+            {"sharedKeys", incremental.shared_keys},
+            {"unassigned", stats.unassigned},
+            {"wastedSeats", stats.wasted_seats}
+        };
+    }
+    else if(allocation_mode == "merged"){
+        merged_lecture_allocation_logic(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor, schedule_patterns);
+        AllocationStats stats = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", "merged"},
+            {"unassigned", stats.unassigned},
+            {"wastedSeats", stats.wasted_seats}
+        };
+    }
+    else{
+        core_lecture_allocation_logic(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor, schedule_patterns);
+        AllocationStats greedy = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary = {
+            {"mode", "greedy"},
+            {"unassigned", greedy.unassigned},
+            {"wastedSeats", greedy.wasted_seats}
+        };
     }
 
-    if(j.contains("convenienceFactor") && j.at("convenienceFactor").is_string()){
-        convenience_factor = std::stoi(j.at("convenience_factor").get<std::string>());
+    // Lectures the allocator could not place get a short ejection-chain repair, bounded by
+    // "repairNodeLimit" halls examined ("repairNodeLimit": 0 turns it off) so the schedule does not
+    // depend on machine load; "repairTimeMs" adds a wall-clock cap for interactive use.
+    RepairOptions repair_options;
+    repair_options.max_depth = json_int(j, "repairDepth", repair_options.max_depth);
+    repair_options.node_limit = json_int(j, "repairNodeLimit", (int)repair_options.node_limit);
+    repair_options.time_budget_ms = json_int(j, "repairTimeMs", repair_options.time_budget_ms);
+    // The portfolio has already repaired every strategy inside its deadline.
+    if(allocation_mode == "portfolio" && !split_components)repair_options.node_limit = 0;
+    RepairResult repair = repair_unassigned_lectures(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, schedule_patterns, repair_options);
+    if(repair.repaired > 0){
+        AllocationStats repaired = allocation_stats(processed_lecture_lists, processed_venue_list);
+        allocation_summary["unassigned"] = repaired.unassigned;
+        allocation_summary["wastedSeats"] = repaired.wasted_seats;
     }
-    core_lecture_allocation_logic(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, convenience_factor);
+    allocation_summary["repair"] = {
+        {"unassignedBefore", repair.unassigned_before},
+        {"repaired", repair.repaired},
+        {"nodes", repair.nodes},
+        {"outOfNodes", repair.out_of_nodes},
+        {"timedOut", repair.timed_out}
+    };
+
+    // Optional annealing pass over whatever the allocator produced.
+    LocalSearchOptions search_options;
+    search_options.time_budget_ms = json_int(j, "localSearchTimeMs", 0);
+    search_options.iterations = json_int(j, "localSearchIterations", 0);
+    search_options.seed = json_int(j, "localSearchSeed", (int)search_options.seed);
+    search_options.chains = json_int(j, "localSearchChains", 0);
+    if(search_options.time_budget_ms > 0 || search_options.iterations > 0){
+        LocalSearchResult improved = improve_lecture_allocation(processed_lecture_lists, processed_venue_list, lecture_building_priority_order, schedule_patterns, search_options);
+        allocation_summary["unassigned"] = improved.after.unassigned;
+        allocation_summary["wastedSeats"] = improved.after.wasted_seats;
+        allocation_summary["localSearch"] = {
+            {"unassignedBefore", improved.before.unassigned},
+            {"wastedSeatsBefore", improved.before.wasted_seats},
+            {"movesTried", improved.moves_tried},
+            {"movesAccepted", improved.moves_accepted},
+            {"bestChain", improved.best_chain}
+        };
+    }
+
+    // Tutorials take the rooms the lectures left free.
+    core_tutorial_allocation_logic(processed_tutorial_lists, processed_venue_list, tutorial_building_priority_order, convenience_factor, schedule_patterns);
+    int rooms_requested = 0;
+    int rooms_assigned = 0;
+    int unscheduled_tutorials = 0;
+    for(auto &tutorial: processed_tutorial_lists){
+        rooms_requested += tutorial.tutorial_count;
+        rooms_assigned += tutorial.assignment.size();
+        if(schedule_patterns.slots(tutorial.tutorial_pattern).none())unscheduled_tutorials++;
+    }
+    allocation_summary["tutorials"] = {
+        {"count", processed_tutorial_lists.size()},
+        {"roomsRequested", rooms_requested},
+        {"roomsAssigned", rooms_assigned},
+        {"withoutSchedule", unscheduled_tutorials}
+    };
+
+    allocation_summary["invalidSchedules"] = invalid_schedules;
+    allocation_summary["missingSchedules"] = missing_schedules;
 
     json output_json;
     output_json["lectureSchedule"] = json::array();
+    output_json["allocationSummary"] = allocation_summary;
+    if(!sweep_output.is_null())output_json["convenienceSweep"] = sweep_output;
+
+    AllocationTable lecture_table = allocation_table(processed_lecture_lists, processed_venue_list, lecture_convenience_factor);
+    for(size_t row = 0; row < lecture_rows.size(); row++){
+        int ind = allocated_index[row];
+        const Lecture &lec = ind == -1 ? lecture_rows[row] : processed_lecture_lists[ind];
+        int venue = ind == -1 ? -1 : lecture_table.venues[ind];
+        ScheduleParseError schedule_error = schedule_patterns.error(lec.lecture_pattern);
+        PlacementStatus status = ind != -1 ? lecture_table.status[ind]
+            : schedule_error != ScheduleParseError::None ? PlacementStatus::InvalidSchedule : PlacementStatus::NoSchedule;
+        json line = {
+            {"Course Name", names.course_names.text(lec.course_name)},
+            {"Course Code", names.course_codes.text(lec.course_code)},
+            {"Building", venue == -1 ? json(nullptr) : json(names.buildings.text(processed_venue_list.building_ids[venue]))},
+            {"Lecture Hall Assigned", venue == -1 ? json(nullptr) : json(names.halls.text(processed_venue_list.hall_names[venue]))},
+            {"Status", placement_status_name(status)}
+        };
+        if(!names.sections.text(lec.section).empty())line["Section"] = names.sections.text(lec.section);
+        if(lec.lecture_pattern != SchedulePatternTable::EMPTY_PATTERN)line["Lecture Schedule"] = schedule_patterns.text(lec.lecture_pattern);
+        if(lec.is_modular())line["Modular Course"] = lec.term_part == TermPart::FirstHalf ? "1" : "2";
+        if(schedule_error != ScheduleParseError::None)line["Schedule Error"] = schedule_parse_error_name(schedule_error);
+        output_json["lectureSchedule"].push_back(line);
+    }
 
-    // for(auto lec: processed_lecture_lists){
-    //     output_json["lectureSchedule"].push_back({
-    //         {"Course Name", lec.course_name},
-    //         {"Course Code", lec.course_code},
-    //         {"Lecture Hall Assigned", lec.assignment}
-    //     });
-    // }
+    // One line per tutorial with the rooms it got; "Shortfall" counts the rooms it asked for but did not get.
+    output_json["tutorialSchedule"] = json::array();
+    for(auto &tut: processed_tutorial_lists){
+        json rooms = json::array();
+        for(auto venue: tut.assignment){
+            rooms.push_back({
+                {"Building", names.buildings.text(processed_venue_list.building_ids[venue])},
+                {"Tutorial Room Assigned", names.halls.text(processed_venue_list.hall_names[venue])}
+            });
+        }
+        json line = {
+            {"Course Name", names.course_names.text(tut.course_name)},
+            {"Course Code", names.course_codes.text(tut.course_code)},
+            {"Tutorial Count", tut.tutorial_count},
+            {"Rooms Assigned", rooms}
+        };
+        if(!names.sections.text(tut.section).empty())line["Section"] = names.sections.text(tut.section);
+        if(tut.tutorial_pattern != SchedulePatternTable::EMPTY_PATTERN)line["Tutorial Schedule"] = schedule_patterns.text(tut.tutorial_pattern);
+        if(tut.is_modular())line["Modular Course"] = tut.term_part == TermPart::FirstHalf ? "1" : "2";
+        if((int)tut.assignment.size() < tut.tutorial_count)line["Shortfall"] = tut.tutorial_count - (int)tut.assignment.size();
+        ScheduleParseError schedule_error = schedule_patterns.error(tut.tutorial_pattern);
+        if(schedule_error != ScheduleParseError::None)line["Schedule Error"] = schedule_parse_error_name(schedule_error);
+        output_json["tutorialSchedule"].push_back(line);
+    }
 
     std::cout << output_json.dump(4) << std::endl;
 
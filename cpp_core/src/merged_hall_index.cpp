@@ -0,0 +1,94 @@
+#include <vector>
+#include <algorithm>
+#include "merged_hall_index.hpp"
+
+MergedHallIndex::MergedHallIndex(const VenueTable &venues, const std::vector<int> &buildings){
+    for(int position = 0; position < (int)buildings.size(); position++){
+        segment_begin.push_back(rank_venue.size());
+        const VenueTable::BuildingRange &range = venues.building_ranges[buildings[position]];
+        for(int venue = range.begin; venue < range.end; venue++){
+            rank_venue.push_back(venue);
+            rank_segment.push_back(position);
+            thresholds.push_back(venues.capacities[venue]);
+        }
+    }
+    segment_begin.push_back(rank_venue.size());
+    words = (size() + 63) / 64;
+
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+    at_least.assign(thresholds.size() * words, 0);
+    for(int rank = 0; rank < size(); rank++){
+        int capacity = venues.capacities[rank_venue[rank]];
+        for(int ind = 0; ind < (int)thresholds.size() && thresholds[ind] <= capacity; ind++){
+            at_least[(size_t)ind * words + (rank >> 6)] |= uint64_t(1) << (rank & 63);
+        }
+    }
+
+    free_rows.assign((size_t)TERM_SLOTS * words, 0);
+    for(int rank = 0; rank < size(); rank++){
+        venues.availability(rank_venue[rank]).for_each_slot([&](int slot){
+            free_rows[(size_t)slot * words + (rank >> 6)] |= uint64_t(1) << (rank & 63);
+        });
+    }
+}
+
+const uint64_t *MergedHallIndex::at_least_row(int seats) const {
+    int ind = std::lower_bound(thresholds.begin(), thresholds.end(), seats) - thresholds.begin();
+    if(ind == (int)thresholds.size())return nullptr;
+    return &at_least[(size_t)ind * words];
+}
+
+int MergedHallIndex::find(const SlotMask &slots, int students, int convenient_size) const {
+    const uint64_t *seated = at_least_row(students);
+    if(!seated)return -1;
+    const uint64_t *convenient = at_least_row(convenient_size);
+
+    TimeGrid::slot_index slot_ids[TERM_SLOTS];
+    int slot_count = 0;
+    slots.for_each_slot([&](int slot){
+        slot_ids[slot_count++] = (TimeGrid::slot_index)slot;
+    });
+    auto free_word = [&](int w){
+        uint64_t acc = seated[w];
+        for(int ind = 0; ind < slot_count && acc; ind++)acc &= free_rows[(size_t)slot_ids[ind] * words + w];
+        return acc;
+    };
+
+    // The first free hall that seats everyone decides the building.
+    int first = -1;
+    int w = 0;
+    uint64_t acc = 0;
+    for(; w < words; w++){
+        acc = free_word(w);
+        if(acc){
+            first = w * 64 + ctz64(acc);
+            break;
+        }
+    }
+    if(first == -1)return -1;
+    int segment = rank_segment[first];
+    int end = segment_begin[segment + 1];
+
+    // Inside that building, ranks run by capacity: the first convenient one, else the last free one below it.
+    int fallback = first;
+    for(; w < words && w * 64 < end; w++){
+        if(w * 64 > first)acc = free_word(w);
+        if(w == (first >> 6))acc &= ~uint64_t(0) << (first & 63);
+        if(((w + 1) * 64) > end && (end & 63))acc &= ~(~uint64_t(0) << (end & 63));
+        if(!acc)continue;
+
+        uint64_t good = convenient ? (acc & convenient[w]) : 0;
+        if(good)return w * 64 + ctz64(good);
+        uint64_t below = convenient ? (acc & ~convenient[w]) : acc;
+        if(below)fallback = w * 64 + msb64(below);
+    }
+    return fallback;
+}
+
+void MergedHallIndex::occupy(int rank, const SlotMask &slots){
+    uint64_t bit = uint64_t(1) << (rank & 63);
+    slots.for_each_slot([&](int slot){
+        free_rows[(size_t)slot * words + (rank >> 6)] &= ~bit;
+    });
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "venue_table.hpp"
+
+/**
+ * @class MergedHallIndex
+ * @brief One free-hall index over the halls of all priority buildings.
+ * Halls are ranked by the combined key (building priority rank, capacity), so the halls of the first
+ * priority building come first, smallest to largest, then those of the second one, and so on. Next to
+ * the slot-major free rows the index keeps, for every distinct capacity, the bitset of ranks with at
+ * least that capacity, so "free and large enough" is an AND of rows for all buildings at once.
+ */
+class MergedHallIndex {
+public:
+    MergedHallIndex() = default;
+
+    /**
+     * @brief Builds the index from the current availability of the halls.
+     * @param buildings Building IDs in priority order, as returned by VenueTable::resolve_buildings.
+     */
+    MergedHallIndex(const VenueTable &venues, const std::vector<int> &buildings);
+
+    int size() const { return (int)rank_venue.size(); }
+
+    int venue_at(int rank) const { return rank_venue[rank]; }
+
+    /**
+     * @brief The greedy's hall for a lecture in one pass: in the first building with any free hall
+     * seating `students`, the smallest free hall of at least `convenient_size`, else the largest free
+     * one below it.
+     * @return The rank, or -1 when no building has a free hall.
+     */
+    int find(const SlotMask &slots, int students, int convenient_size) const;
+
+    // Marks the hall with the given rank as booked for the slots of the mask.
+    void occupy(int rank, const SlotMask &slots);
+
+private:
+    int words = 0;
+    std::vector<int> rank_venue;
+    std::vector<int> rank_segment;     // priority position of the rank's building
+    std::vector<int> segment_begin;    // first rank per priority position, plus the end
+    std::vector<int> thresholds;       // distinct capacities, ascending
+    std::vector<uint64_t> at_least;    // per threshold: `words` words, bit r set when capacity >= threshold
+    std::vector<uint64_t> free_rows;   // TERM_SLOTS rows of `words` words
+
+    // Bitset row of ranks with capacity >= seats, nullptr when there are none.
+    const uint64_t *at_least_row(int seats) const;
+};
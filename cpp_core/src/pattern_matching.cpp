@@ -0,0 +1,159 @@
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include "pattern_matching.hpp"
+#include "sort_order.hpp"
+
+namespace {
+
+constexpr long long NO_EDGE = std::numeric_limits<long long>::max() / 4;
+
+/**
+ * Hungarian algorithm (shortest augmenting paths with potentials) for a rows x cols cost matrix,
+ * rows <= cols. Returns the column matched to every row.
+ */
+std::vector<int> min_cost_assignment(const std::vector<long long> &cost, int rows, int cols){
+    std::vector<long long> u(rows + 1, 0), v(cols + 1, 0);
+    std::vector<int> match(cols + 1, 0), way(cols + 1, 0);
+    std::vector<long long> min_reduced(cols + 1);
+    std::vector<char> used(cols + 1);
+
+    for(int row = 1; row <= rows; row++){
+        match[0] = row;
+        int col0 = 0;
+        std::fill(min_reduced.begin(), min_reduced.end(), NO_EDGE);
+        std::fill(used.begin(), used.end(), 0);
+        do{
+            used[col0] = 1;
+            int row0 = match[col0];
+            long long delta = NO_EDGE;
+            int col1 = 0;
+            for(int col = 1; col <= cols; col++){
+                if(used[col])continue;
+                long long reduced = cost[(size_t)(row0 - 1) * cols + (col - 1)] - u[row0] - v[col];
+                if(reduced < min_reduced[col]){
+                    min_reduced[col] = reduced;
+                    way[col] = col0;
+                }
+                if(min_reduced[col] < delta){
+                    delta = min_reduced[col];
+                    col1 = col;
+                }
+            }
+            for(int col = 0; col <= cols; col++){
+                if(used[col]){
+                    u[match[col]] += delta;
+                    v[col] -= delta;
+                }
+                else min_reduced[col] -= delta;
+            }
+            col0 = col1;
+        }while(match[col0] != 0);
+
+        do{
+            int col1 = way[col0];
+            match[col0] = match[col1];
+            col0 = col1;
+        }while(col0);
+    }
+
+    std::vector<int> assigned(rows, -1);
+    for(int col = 1; col <= cols; col++){
+        if(match[col])assigned[match[col] - 1] = col - 1;
+    }
+    return assigned;
+}
+
+struct PatternClass {
+    SlotMask slots;
+    std::vector<int> lectures;
+    int largest = 0;
+    bool overlaps = false;
+};
+
+// Matches one class against the halls still free for its slots and books the result.
+void match_class(const PatternClass &pattern, std::vector<Lecture> &lectures, VenueTable &venues, const std::vector<int> &buildings){
+    int smallest = std::numeric_limits<int>::max();
+    for(auto lecture: pattern.lectures)smallest = std::min(smallest, lectures[lecture].students_registered);
+
+    std::vector<int> halls;
+    std::vector<int> hall_rank;
+    for(int rank = 0; rank < (int)buildings.size(); rank++){
+        const VenueTable::BuildingRange &range = venues.building_ranges[buildings[rank]];
+        int first = range.begin + venues.capacity_indexes[buildings[rank]].lower_bound_rank(smallest);
+        for(int venue = first; venue < range.end; venue++){
+            if(!venues.is_free(venue, pattern.slots))continue;
+            halls.push_back(venue);
+            hall_rank.push_back(rank);
+        }
+    }
+    if(halls.empty())return;
+
+    // Every lecture gets its own "unassigned" column, priced above any set of placements so that
+    // the matching places as many lectures as it can before it looks at waste.
+    int rows = pattern.lectures.size();
+    int cols = halls.size() + rows;
+    long long max_cost = 0;
+    for(int col = 0; col < (int)halls.size(); col++){
+        max_cost = std::max(max_cost, (long long)venues.capacities[halls[col]] + hall_rank[col]);
+    }
+    long long unassigned_cost = (long long)rows * (max_cost + 1) + 1;
+
+    std::vector<long long> cost((size_t)rows * cols, unassigned_cost);
+    for(int row = 0; row < rows; row++){
+        int students = lectures[pattern.lectures[row]].students_registered;
+        for(int col = 0; col < (int)halls.size(); col++){
+            int capacity = venues.capacities[halls[col]];
+            cost[(size_t)row * cols + col] = capacity < students ? NO_EDGE : capacity - students + hall_rank[col];
+        }
+    }
+
+    std::vector<int> assigned = min_cost_assignment(cost, rows, cols);
+    for(int row = 0; row < rows; row++){
+        if(assigned[row] < 0 || assigned[row] >= (int)halls.size())continue;
+        Lecture &lecture = lectures[pattern.lectures[row]];
+        int venue = halls[assigned[row]];
+        lecture.assignLectureHall(venue);
+        venues.book(venue, lecture.course_code, lecture.section, pattern.slots);
+    }
+}
+
+}
+
+PatternMatchingResult pattern_matching_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns){
+    std::vector<int> buildings = venues.resolve_buildings(lecture_building_priority_order);
+
+    // Different schedule strings can parse to the same slots, so classes are keyed by the mask.
+    std::vector<PatternClass> classes;
+    std::unordered_map<SlotMask, int> class_of;
+    for(int lecture = 0; lecture < (int)lectures.size(); lecture++){
+        const SlotMask &slots = schedule_patterns.slots(lectures[lecture].lecture_pattern);
+        auto found = class_of.emplace(slots, (int)classes.size());
+        if(found.second){
+            classes.emplace_back();
+            classes.back().slots = slots;
+        }
+        PatternClass &pattern = classes[found.first->second];
+        pattern.lectures.push_back(lecture);
+        pattern.largest = std::max(pattern.largest, lectures[lecture].students_registered);
+    }
+
+    PatternMatchingResult result;
+    result.pattern_classes = classes.size();
+    for(int a = 0; a < (int)classes.size(); a++){
+        for(int b = a + 1; b < (int)classes.size(); b++){
+            if(classes[a].slots.intersects(classes[b].slots)){
+                classes[a].overlaps = true;
+                classes[b].overlaps = true;
+            }
+        }
+        if(classes[a].overlaps)result.overlapping_classes++;
+    }
+    result.optimal = result.overlapping_classes == 0;
+
+    for(auto ind: counting_sort_order(classes.size(), [&classes](int ind){ return -classes[ind].largest; })){
+        match_class(classes[ind], lectures, venues, buildings);
+    }
+    return result;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+
+struct PatternMatchingResult {
+    int pattern_classes = 0;     // distinct slot sets among the lectures
+    int overlapping_classes = 0; // classes sharing a slot with another class
+    bool optimal = false;        // no class overlaps another, so the per-class optima add up
+};
+
+/**
+ * @brief Assigns lectures to halls one pattern class at a time.
+ * Lectures with the same slot set compete for exactly the same halls, so each class is solved as a
+ * min-cost bipartite matching (lecture -> hall) with cost = wasted seats + building priority rank,
+ * placing as many lectures as possible first. Classes whose slots overlap another class are matched
+ * in turn, the class holding the largest lecture first, against the halls left by earlier classes.
+ * Only halls of the priority buildings are used and halls already booked in the VenueTable stay booked.
+ */
+PatternMatchingResult pattern_matching_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, const SchedulePatternTable &schedule_patterns);
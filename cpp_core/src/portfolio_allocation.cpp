@@ -0,0 +1,142 @@
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+#include "portfolio_allocation.hpp"
+#include "thread_pool.hpp"
+#include "sort_order.hpp"
+#include "exact_allocation.hpp"
+#include "pattern_matching.hpp"
+#include "ejection_repair.hpp"
+#include "local_search.hpp"
+
+namespace {
+
+constexpr long long LOCAL_SEARCH_SLICE = 20000;
+
+const char *const STRATEGIES[] = {"ascending", "descending", "dynamic", "buildingFirst", "matching", "exact"};
+constexpr int STRATEGY_COUNT = sizeof(STRATEGIES) / sizeof(STRATEGIES[0]);
+
+// Unassigned lectures in the high bits, wasted seats in the low 40, so smaller is better.
+uint64_t score_of(const AllocationStats &stats){
+    uint64_t waste = (uint64_t)std::min<long long>(std::max<long long>(stats.wasted_seats, 0), (1ll << 40) - 1);
+    return ((uint64_t)stats.unassigned << 40) | waste;
+}
+
+void publish(std::atomic<uint64_t> &best_score, uint64_t score){
+    uint64_t seen = best_score.load(std::memory_order_relaxed);
+    while(score < seen && !best_score.compare_exchange_weak(seen, score, std::memory_order_relaxed)){}
+}
+
+int remaining_ms(std::chrono::steady_clock::time_point deadline){
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    return (int)std::max<long long>(left, 0);
+}
+
+void construct(int strategy, std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &priority, int convenience_factor, const SchedulePatternTable &schedule_patterns, std::chrono::steady_clock::time_point deadline){
+    std::vector<int> order(lectures.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto students_of = [&lectures](int ind){ return lectures[ind].students_registered; };
+
+    switch(strategy){
+        case 0:
+            core_lecture_allocation_logic(lectures, venues, priority, convenience_factor, schedule_patterns);
+            break;
+        case 1:
+            counting_sort_indices(order, [&lectures](int ind){ return -lectures[ind].students_registered; });
+            ordered_lecture_allocation_logic(lectures, venues, priority, convenience_factor, schedule_patterns, order);
+            break;
+        case 2:
+            dynamic_lecture_allocation_logic(lectures, venues, priority, convenience_factor, schedule_patterns);
+            break;
+        case 3:
+            // Fill each building with every lecture it can take before the next one is opened.
+            counting_sort_indices(order, students_of);
+            for(auto building: venues.resolve_buildings(priority)){
+                std::vector<uint32_t> single = {(uint32_t)building};
+                ordered_lecture_allocation_logic(lectures, venues, single, convenience_factor, schedule_patterns, order);
+            }
+            break;
+        case 4:
+            pattern_matching_allocation(lectures, venues, priority, schedule_patterns);
+            break;
+        default: {
+            ExactAllocationLimits limits;
+            limits.node_limit = 1ll << 62;
+            limits.time_limit_ms = remaining_ms(deadline) / STRATEGY_COUNT;
+            exact_lecture_allocation(lectures, venues, priority, schedule_patterns, limits);
+            break;
+        }
+    }
+}
+
+}
+
+PortfolioResult portfolio_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns, const PortfolioOptions &options){
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, options.time_budget_ms));
+    std::atomic<uint64_t> best_score(UINT64_MAX);
+
+    PortfolioResult result;
+    result.runs.resize(STRATEGY_COUNT);
+    std::vector<std::vector<Lecture>> run_lectures(STRATEGY_COUNT, lectures);
+    std::vector<VenueTable> run_venues(STRATEGY_COUNT, venues);
+    std::vector<std::unique_ptr<AnnealingRun>> searches(STRATEGY_COUNT);
+
+    {
+        ThreadPool pool(std::min(options.threads > 0 ? options.threads : ThreadPool::default_threads(), STRATEGY_COUNT));
+
+        // Improvement runs as one task per slice that queues the next one, so strategies take turns
+        // even when there are fewer threads than strategies. Each strategy's annealing instance is
+        // built once and its chain is stepped on the worker itself.
+        std::function<void(int)> improve = [&](int strategy){
+            PortfolioRun &run = result.runs[strategy];
+            if(remaining_ms(deadline) == 0)return;
+
+            bool improved = searches[strategy]->step(LOCAL_SEARCH_SLICE, deadline);
+            run.stats = searches[strategy]->best();
+            uint64_t score = score_of(run.stats);
+            publish(best_score, score);
+
+            if(!improved && score > best_score.load(std::memory_order_relaxed)){
+                run.stopped_early = remaining_ms(deadline) > 0;
+                return;
+            }
+            pool.submit([&improve, strategy]{ improve(strategy); });
+        };
+
+        for(int strategy = 0; strategy < STRATEGY_COUNT; strategy++){
+            pool.submit([&, strategy]{
+                std::vector<Lecture> &own_lectures = run_lectures[strategy];
+                VenueTable &own_venues = run_venues[strategy];
+                PortfolioRun &run = result.runs[strategy];
+                run.strategy = STRATEGIES[strategy];
+
+                construct(strategy, own_lectures, own_venues, lecture_building_priority_order, convenience_factor, schedule_patterns, deadline);
+                RepairOptions repair;
+                repair.time_budget_ms = std::max(1, remaining_ms(deadline));
+                repair_unassigned_lectures(own_lectures, own_venues, lecture_building_priority_order, schedule_patterns, repair);
+                run.stats = allocation_stats(own_lectures, own_venues);
+                publish(best_score, score_of(run.stats));
+
+                if(remaining_ms(deadline) == 0)return;
+                searches[strategy] = std::make_unique<AnnealingRun>(own_lectures, own_venues, lecture_building_priority_order, schedule_patterns, options.seed + (uint64_t)strategy * 1000003);
+                pool.submit([&improve, strategy]{ improve(strategy); });
+            });
+        }
+        pool.wait();
+    }
+
+    for(int strategy = 0; strategy < STRATEGY_COUNT; strategy++){
+        if(result.winner == -1 || score_of(result.runs[strategy].stats) < score_of(result.runs[result.winner].stats)){
+            result.winner = strategy;
+        }
+    }
+    if(searches[result.winner])searches[result.winner]->commit(run_lectures[result.winner], run_venues[result.winner]);
+    lectures.swap(run_lectures[result.winner]);
+    venues = std::move(run_venues[result.winner]);
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
+#include "lecture_allocation.hpp"
+
+struct PortfolioOptions {
+    int time_budget_ms = 1000; // global deadline for every strategy
+    int threads = 0;           // ThreadPool::default_threads() when <= 0
+    uint64_t seed = 1;         // base seed of the strategies' local-search slices
+};
+
+struct PortfolioRun {
+    std::string strategy;
+    AllocationStats stats;
+    bool stopped_early = false; // gave up behind the shared best before the deadline
+};
+
+struct PortfolioResult {
+    int winner = -1;           // index into runs
+    std::vector<PortfolioRun> runs;
+};
+
+/**
+ * @brief Races several allocation strategies on separate copies of the lectures and venue table.
+ * Strategies: ascending and descending size order, most-constrained-first, building-first, pattern
+ * matching and the exact solver. Each one builds an assignment, repairs it with ejection chains and
+ * then improves it with short slices of one annealing chain (an AnnealingRun) until the deadline. After every slice it publishes
+ * its score in a shared atomic best-score slot; a strategy whose slice brought nothing while it is
+ * behind the shared best stops early. The winner (fewest unassigned, then least waste, then first
+ * in the list) is written into lectures and venues.
+ */
+PortfolioResult portfolio_lecture_allocation(std::vector<Lecture> &lectures, VenueTable &venues, std::vector<uint32_t> &lecture_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns, const PortfolioOptions &options);
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "slot_mask.hpp"
+#include "helper.hpp"
+#include "string_pool.hpp"
+
+/**
+ * @class SchedulePatternTable
+ * @brief Interns schedule strings such as "MWF 09:00-10:00", per part of the term.
+ * Every distinct string is parsed once; every (string, TermPart) pair gets a pattern ID whose
+ * slots cover the halves of the term that part runs in. Courses, lectures and tutorials keep the
+ * small pattern ID instead of their own copy. Two lectures with the same ID compete for exactly
+ * the same slots, and a first-half and a second-half pattern never overlap.
+ */
+class SchedulePatternTable {
+public:
+    // ID of the empty schedule, used by courses without a lecture or tutorial schedule.
+    static constexpr int EMPTY_PATTERN = 0;
+
+    SchedulePatternTable(){
+        intern("");
+    }
+
+    /**
+     * @brief Returns the ID of a schedule string in a part of the term, parsing it on first sight.
+     * A malformed string still gets an ID, with no slots and its parse error recorded.
+     */
+    int intern(std::string_view schedule, TermPart part = TermPart::Full){
+        uint32_t text = texts.find(schedule);
+        if(text == StringPool::NO_ID){
+            text = texts.intern(schedule);
+            ParsedText parsed;
+            parsed.error = parse_schedule(schedule, parsed.week);
+            if(parsed.error != ScheduleParseError::None)parsed.week = SlotMask();
+            parsed_texts.push_back(parsed);
+        }
+
+        int &id = parsed_texts[text].patterns[(int)part];
+        if(id != -1)return id;
+        id = masks.size();
+        masks.push_back(in_term(parsed_texts[text].week, part));
+        text_ids.push_back(text);
+        parts.push_back(part);
+        return id;
+    }
+
+    // ID of a schedule string already interned for a part of the term, -1 otherwise.
+    int find(std::string_view schedule, TermPart part = TermPart::Full) const {
+        uint32_t text = texts.find(schedule);
+        return text == StringPool::NO_ID ? -1 : parsed_texts[text].patterns[(int)part];
+    }
+
+    const SlotMask &slots(int id) const { return masks[id]; }
+
+    const std::string &text(int id) const { return texts.text(text_ids[id]); }
+
+    TermPart part(int id) const { return parts[id]; }
+
+    ScheduleParseError error(int id) const { return parsed_texts[text_ids[id]].error; }
+
+    int size() const { return (int)masks.size(); }
+
+private:
+    struct ParsedText {
+        SlotMask week;                    // weekly slots, below WEEK_SLOTS
+        ScheduleParseError error = ScheduleParseError::None;
+        int patterns[3] = {-1, -1, -1};   // pattern ID per TermPart, -1 until interned
+    };
+
+    StringPool texts;
+    std::vector<ParsedText> parsed_texts; // per string ID
+    std::vector<SlotMask> masks;          // per pattern ID
+    std::vector<uint32_t> text_ids;
+    std::vector<TermPart> parts;
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include "bit_ops.hpp"
+#include "time_model.hpp"
+
+/**
+ * @class BasicSlotMask
+ * @brief Fixed-size bitmask with one bit per slot of a grid.
+ * @tparam Bits Number of slots in the grid, so the word count is fixed at compile time.
+ */
+template <int Bits>
+class BasicSlotMask {
+public:
+    static constexpr int WORDS = (Bits + 63) / 64;
+    std::array<uint64_t, WORDS> bits{};
+
+    void set(int slot){
+        bits[slot >> 6] |= uint64_t(1) << (slot & 63);
+    }
+
+    void reset(int slot){
+        bits[slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+    }
+
+    // Sets the slots [begin, end).
+    void set_range(int begin, int end){
+        while(begin < end){
+            int w = begin >> 6;
+            int stop = std::min(end, (w + 1) * 64);
+            int width = stop - begin;
+            uint64_t run = (width == 64) ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
+            bits[w] |= run << (begin & 63);
+            begin = stop;
+        }
+    }
+
+    bool test(int slot) const {
+        return (bits[slot >> 6] >> (slot & 63)) & 1;
+    }
+
+    bool none() const {
+        for(int w = 0; w < WORDS; w++){
+            if(bits[w])return false;
+        }
+        return true;
+    }
+
+    int count() const {
+        int total = 0;
+        for(int w = 0; w < WORDS; w++)total += popcount64(bits[w]);
+        return total;
+    }
+
+    // True when every slot of `other` is also set here.
+    bool contains(const BasicSlotMask &other) const {
+        for(int w = 0; w < WORDS; w++){
+            if(other.bits[w] & ~bits[w])return false;
+        }
+        return true;
+    }
+
+    bool intersects(const BasicSlotMask &other) const {
+        for(int w = 0; w < WORDS; w++){
+            if(other.bits[w] & bits[w])return true;
+        }
+        return false;
+    }
+
+    // Clears every slot that is set in `other`.
+    void remove(const BasicSlotMask &other){
+        for(int w = 0; w < WORDS; w++)bits[w] &= ~other.bits[w];
+    }
+
+    BasicSlotMask &operator|=(const BasicSlotMask &other){
+        for(int w = 0; w < WORDS; w++)bits[w] |= other.bits[w];
+        return *this;
+    }
+
+    BasicSlotMask &operator&=(const BasicSlotMask &other){
+        for(int w = 0; w < WORDS; w++)bits[w] &= other.bits[w];
+        return *this;
+    }
+
+    bool operator==(const BasicSlotMask &other) const {
+        return bits == other.bits;
+    }
+
+    bool operator!=(const BasicSlotMask &other) const {
+        return bits != other.bits;
+    }
+
+    /**
+     * @brief Calls f(slot) for every set slot in ascending order.
+     */
+    template <typename F>
+    void for_each_slot(F f) const {
+        for(int w = 0; w < WORDS; w++){
+            uint64_t word = bits[w];
+            while(word){
+                f(w * 64 + ctz64(word));
+                word &= word - 1;
+            }
+        }
+    }
+};
+
+// Mask over the configured term: bit half * WEEK_SLOTS + TimeGrid::slot_of(day_index, minute)
+// stands for that slot in that half. A weekly schedule is parsed into the first WEEK_SLOTS bits.
+using SlotMask = BasicSlotMask<TERM_SLOTS>;
+
+/**
+ * @brief Copies the weekly slots of `week` (bits below WEEK_SLOTS) into every half of the term
+ * that `part` runs in.
+ */
+inline SlotMask in_term(const SlotMask &week, TermPart part){
+    SlotMask term;
+    for(int half = 0; half < TimeGrid::term_halves; half++){
+        if(part == TermPart::FirstHalf && half != 0)continue;
+        if(part == TermPart::SecondHalf && half != 1)continue;
+        week.for_each_slot([&term, half](int slot){
+            if(slot < WEEK_SLOTS)term.set(half * WEEK_SLOTS + slot);
+        });
+    }
+    return term;
+}
+
+namespace std {
+template <int Bits>
+struct hash<BasicSlotMask<Bits>> {
+    size_t operator()(const BasicSlotMask<Bits> &mask) const {
+        uint64_t h = 0;
+        for(auto word: mask.bits)h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+        return (size_t)(h ^ (h >> 32));
+    }
+};
+}
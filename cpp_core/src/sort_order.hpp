@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <numeric>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @brief Stably reorders a list of indices by an integer key, without moving the objects they index.
+ * Keys spanning fewer than 2^16 values take one counting pass over [min, max]; wider keys take two
+ * 16-bit radix passes. Either way the cost is linear in the number of indices.
+ * @param key_of Called once per index, returns the key as an int.
+ */
+template <typename KeyOf>
+void counting_sort_indices(std::vector<int> &order, KeyOf key_of){
+    int count = order.size();
+    if(count < 2)return;
+
+    // Keys are biased so that signed order becomes unsigned order.
+    std::vector<uint32_t> keys(count);
+    uint32_t low = UINT32_MAX;
+    uint32_t high = 0;
+    for(int ind = 0; ind < count; ind++){
+        keys[ind] = (uint32_t)key_of(order[ind]) ^ 0x80000000u;
+        low = std::min(low, keys[ind]);
+        high = std::max(high, keys[ind]);
+    }
+
+    std::vector<int> sorted(count);
+    std::vector<uint32_t> sorted_keys(count);
+    auto pass = [&](uint32_t base, int shift, uint32_t buckets){
+        std::vector<int> start(buckets + 1, 0);
+        for(int ind = 0; ind < count; ind++)start[(((keys[ind] - base) >> shift) & 0xFFFF) + 1]++;
+        for(uint32_t bucket = 0; bucket < buckets; bucket++)start[bucket + 1] += start[bucket];
+        for(int ind = 0; ind < count; ind++){
+            int slot = start[((keys[ind] - base) >> shift) & 0xFFFF]++;
+            sorted[slot] = order[ind];
+            sorted_keys[slot] = keys[ind];
+        }
+        order.swap(sorted);
+        keys.swap(sorted_keys);
+    };
+
+    if(high - low < 0x10000u){
+        pass(low, 0, high - low + 1);
+        return;
+    }
+    pass(0, 0, 0x10000u);
+    pass(0, 16, 0x10000u);
+}
+
+// Indices [0, count) in stable ascending order of key_of(index).
+template <typename KeyOf>
+std::vector<int> counting_sort_order(int count, KeyOf key_of){
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    counting_sort_indices(order, key_of);
+    return order;
+}
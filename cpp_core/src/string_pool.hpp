@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @class StringPool
+ * @brief Interns strings as dense 32-bit IDs; each distinct string is stored once.
+ * The pipeline passes IDs around and only turns them back into text when writing output.
+ */
+class StringPool {
+public:
+    static constexpr uint32_t NO_ID = UINT32_MAX;
+
+    StringPool() = default;
+
+    // The string views used as keys point into `texts`, so a pool is moved, never copied.
+    StringPool(const StringPool &) = delete;
+    StringPool &operator=(const StringPool &) = delete;
+    StringPool(StringPool &&) = default;
+    StringPool &operator=(StringPool &&) = default;
+
+    // Returns the ID of a string, adding it on first sight.
+    uint32_t intern(std::string_view text){
+        auto found = ids.find(text);
+        if(found != ids.end())return found->second;
+
+        uint32_t id = texts.size();
+        texts.emplace_back(text);
+        ids.emplace(texts.back(), id);
+        return id;
+    }
+
+    // Returns the ID of a string, or NO_ID when it was never interned.
+    uint32_t find(std::string_view text) const {
+        auto found = ids.find(text);
+        return found == ids.end() ? NO_ID : found->second;
+    }
+
+    const std::string &text(uint32_t id) const { return texts[id]; }
+
+    uint32_t size() const { return (uint32_t)texts.size(); }
+
+private:
+    std::deque<std::string> texts;
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+/**
+ * @struct NamePools
+ * @brief The interned names of one run: course codes, course names, sections, halls and buildings.
+ * Sections and course names intern "" as ID 0 so a course without one still has an ID.
+ */
+struct NamePools {
+    StringPool course_codes;
+    StringPool course_names;
+    StringPool sections;
+    StringPool halls;
+    StringPool buildings;
+
+    NamePools(){
+        course_names.intern("");
+        sections.intern("");
+    }
+};
@@ -0,0 +1,69 @@
+#include <thread>
+#include <algorithm>
+#include "thread_pool.hpp"
+
+int ThreadPool::default_threads(){
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+ThreadPool::ThreadPool(int threads){
+    for(int ind = 0; ind < std::max(1, threads); ind++){
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    task_ready.notify_all();
+    for(auto &worker: workers)worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task){
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.push_back(std::move(task));
+    }
+    task_ready.notify_one();
+}
+
+void ThreadPool::wait(){
+    std::unique_lock<std::mutex> guard(lock);
+    all_done.wait(guard, [this]{ return tasks.empty() && running == 0; });
+    if(failure){
+        std::exception_ptr thrown = failure;
+        failure = nullptr;
+        std::rethrow_exception(thrown);
+    }
+}
+
+void ThreadPool::work(){
+    while(true){
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            task_ready.wait(guard, [this]{ return stopping || !tasks.empty(); });
+            if(tasks.empty())return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            running++;
+        }
+
+        std::exception_ptr thrown;
+        try{
+            task();
+        }
+        catch(...){
+            thrown = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            running--;
+            if(thrown && !failure)failure = thrown;
+            if(tasks.empty() && running == 0)all_done.notify_all();
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads taking tasks from one queue.
+ * Tasks must not touch shared state without their own synchronisation; the first exception a task
+ * throws is rethrown by wait().
+ */
+class ThreadPool {
+public:
+    // Number of hardware threads, at least 1.
+    static int default_threads();
+
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int size() const { return (int)workers.size(); }
+
+    void submit(std::function<void()> task);
+
+    // Blocks until every submitted task has finished.
+    void wait();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable task_ready;
+    std::condition_variable all_done;
+    int running = 0;
+    bool stopping = false;
+    std::exception_ptr failure;
+
+    void work();
+};
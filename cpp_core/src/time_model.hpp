@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#ifndef SCHEDULE_SLOT_MINUTES
+#define SCHEDULE_SLOT_MINUTES 30
+#endif
+
+/**
+ * @struct WeekDay
+ * @brief One day of the week as it appears in the input data.
+ * code is the abbreviation used in schedule strings, name the key used in hall opening hours.
+ */
+struct WeekDay {
+    char code[3];
+    const char *name;
+};
+
+// Days in index order; a day's position here is its day index everywhere in the engine.
+inline constexpr WeekDay WEEK_DAYS[] = {
+    {"M", "monday"},
+    {"T", "tuesday"},
+    {"W", "wednesday"},
+    {"Th", "thursday"},
+    {"F", "friday"},
+    {"Sa", "saturday"},
+    {"Su", "sunday"},
+};
+
+constexpr int DAYS_PER_WEEK = sizeof(WEEK_DAYS) / sizeof(WEEK_DAYS[0]);
+
+/**
+ * @struct DayCodeTable
+ * @brief Day index for every (upper-case letter, optional lower-case letter) code, -1 if none.
+ * Column 0 holds one-letter codes, column 1 + (c - 'a') two-letter codes ending in c.
+ */
+struct DayCodeTable {
+    int8_t day[26][27];
+};
+
+constexpr DayCodeTable make_day_code_table(){
+    DayCodeTable table{};
+    for(int first = 0; first < 26; first++){
+        for(int second = 0; second < 27; second++)table.day[first][second] = -1;
+    }
+    for(int day = 0; day < DAYS_PER_WEEK; day++){
+        const char *code = WEEK_DAYS[day].code;
+        table.day[code[0] - 'A'][code[1] ? code[1] - 'a' + 1 : 0] = (int8_t)day;
+    }
+    return table;
+}
+
+inline constexpr DayCodeTable DAY_CODES = make_day_code_table();
+
+/**
+ * @brief Weeks of the term a schedule runs in. Modular courses run for one half of the term, so a
+ * first-half and a second-half module can hold the same hall at the same time of the week.
+ */
+enum class TermPart : uint8_t {
+    Full,
+    FirstHalf,
+    SecondHalf,
+};
+
+/**
+ * @struct TimeModel
+ * @brief Compile-time description of the slot grid (every day of WEEK_DAYS, whole days, in each
+ * half of the term).
+ * Slots are indexed densely as half * week_slots + day_index * slots_per_day + slot_of_day.
+ * @tparam SlotMinutes Width of one slot in minutes; must divide an hour (30, 15, 10, 5).
+ */
+template <int SlotMinutes>
+struct TimeModel {
+    static_assert(SlotMinutes > 0 && 60 % SlotMinutes == 0, "slot width must divide an hour");
+
+    static constexpr int slot_minutes = SlotMinutes;
+    static constexpr int days_per_week = DAYS_PER_WEEK;
+    static constexpr int slots_per_day = (24 * 60) / SlotMinutes;
+    static constexpr int week_slots = days_per_week * slots_per_day;
+    static constexpr int term_halves = 2;
+    static constexpr int term_slots = term_halves * week_slots;
+
+    // Smallest unsigned type that can hold any slot index of the term.
+    using slot_index = std::conditional_t<(term_slots <= 256), uint8_t, uint16_t>;
+
+    /**
+     * @brief Returns the index of the slot containing a minute of a day.
+     * @param day_index Position of the day in WEEK_DAYS (0 is monday).
+     * @param minute_of_day Minutes since midnight.
+     */
+    static constexpr int slot_of(int day_index, int minute_of_day){
+        return day_index * slots_per_day + minute_of_day / SlotMinutes;
+    }
+
+    // Index within a day of the first slot that starts at or after minute_of_day.
+    static constexpr int slot_ceil(int minute_of_day){
+        return (minute_of_day + SlotMinutes - 1) / SlotMinutes;
+    }
+};
+
+// The grid the engine is built for; pick another width with -DSCHEDULE_SLOT_MINUTES=15 etc.
+using TimeGrid = TimeModel<SCHEDULE_SLOT_MINUTES>;
+
+constexpr int SLOT_MINUTES = TimeGrid::slot_minutes;
+constexpr int SLOTS_PER_DAY = TimeGrid::slots_per_day;
+constexpr int WEEK_SLOTS = TimeGrid::week_slots;
+constexpr int TERM_SLOTS = TimeGrid::term_slots;
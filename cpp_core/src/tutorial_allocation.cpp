@@ -1,9 +1,81 @@
 #include <vector>
 #include <string>
-#include <map>
-#include <unordered_map>
+#include <algorithm>
 #include "ds.hpp"
+#include "venue_table.hpp"
+#include "free_hall_index.hpp"
+#include "schedule_pattern.hpp"
+#include "tutorial_allocation.hpp"
+#include "sort_order.hpp"
 
-void core_lecture_allocation_logic(std::vector<Tutorial> &tutorials, std::map<std::string, std::vector<Venue>> &venues, std::vector<std::string> &tutorial_building_priority_order, int convenience_factor){
-    return;   
-}
\ No newline at end of file
+namespace {
+
+int room_size(const Tutorial &tutorial){
+    if(tutorial.tutorial_count <= 0)return 0;
+    return (tutorial.students_registered + tutorial.tutorial_count - 1) / tutorial.tutorial_count;
+}
+
+/**
+ * Collects up to `count` free rooms of one building: convenient ones from the smallest up, then
+ * the largest ones that still seat room_seats.
+ */
+int collect_rooms(const FreeHallIndex &halls, const SlotMask &slots, int room_seats, int convenient_size, int count, int *out){
+    int convenient_rank = halls.lower_bound_rank(convenient_size);
+    int found = halls.first_free_n(slots, convenient_rank, halls.size(), count, out);
+    found += halls.last_free_n(slots, halls.lower_bound_rank(room_seats), convenient_rank, count - found, out + found);
+    return found;
+}
+
+}
+
+void core_tutorial_allocation_logic(std::vector<Tutorial> &tutorials, VenueTable &venues, std::vector<uint32_t> &tutorial_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns){
+
+    std::vector<int> order = counting_sort_order(tutorials.size(), [&tutorials](int ind){ return room_size(tutorials[ind]); });
+
+    std::vector<int> priority_buildings = venues.resolve_buildings(tutorial_building_priority_order);
+    std::vector<FreeHallIndex> free_halls(venues.building_count());
+    for(auto building: priority_buildings){
+        free_halls[building] = FreeHallIndex(venues, building);
+    }
+
+    std::vector<int> ranks;
+    for(auto ind: order){
+        Tutorial &tutorial = tutorials[ind];
+        tutorial.assignment.clear();
+        if(tutorial.tutorial_count <= 0)continue;
+
+        // A tutorial without slots (no schedule, or one that does not parse) would book nothing.
+        const SlotMask &tutorial_slots = schedule_patterns.slots(tutorial.tutorial_pattern);
+        if(tutorial_slots.none())continue;
+        int room_seats = room_size(tutorial);
+        int convenient_size = (room_seats * (convenience_factor + 100))/100;
+        ranks.resize(tutorial.tutorial_count);
+
+        // One building holding every room, else rooms gathered along the priority order.
+        std::vector<std::pair<int, int>> rooms; // (building, rank)
+        for(auto building: priority_buildings){
+            int found = collect_rooms(free_halls[building], tutorial_slots, room_seats, convenient_size, tutorial.tutorial_count, ranks.data());
+            if(found == tutorial.tutorial_count){
+                for(int pick = 0; pick < found; pick++)rooms.push_back({building, ranks[pick]});
+                break;
+            }
+        }
+        if(rooms.empty()){
+            for(auto building: priority_buildings){
+                int wanted = tutorial.tutorial_count - (int)rooms.size();
+                if(wanted == 0)break;
+                int found = collect_rooms(free_halls[building], tutorial_slots, room_seats, convenient_size, wanted, ranks.data());
+                for(int pick = 0; pick < found; pick++)rooms.push_back({building, ranks[pick]});
+            }
+        }
+
+        for(auto &room: rooms){
+            FreeHallIndex &halls = free_halls[room.first];
+            int venue = halls.venue_at(room.second);
+            tutorial.assignment.push_back(venue);
+            venues.book(venue, tutorial.course_code, tutorial.section, tutorial_slots);
+            halls.occupy(room.second, tutorial_slots);
+        }
+    }
+    return;
+}
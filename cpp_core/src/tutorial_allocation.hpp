@@ -2,7 +2,18 @@
 
 #include <vector>
 #include <string>
-#include <map>
 #include "ds.hpp"
+#include "venue_table.hpp"
+#include "schedule_pattern.hpp"
 
-void core_lecture_allocation_logic(std::vector<Tutorial> &tutorials, std::map<std::string, std::vector<Venue>> &venues, std::vector<std::string> &tutorial_building_priority_order, int convenience_factor);
\ No newline at end of file
+/**
+ * @brief Gives every tutorial tutorial_count rooms for its slots.
+ * Each room seats ceil(students_registered / tutorial_count); like lectures, a tutorial first takes
+ * rooms at or above the convenient size (room size plus convenience_factor percent) and then the
+ * largest free rooms below it. All rooms of a tutorial come from one building when a building in the
+ * priority order can hold them all, else from the buildings in priority order. A tutorial's rooms
+ * are pulled from a building in one pass over its FreeHallIndex rows. Tutorials that do not get all
+ * their rooms keep the ones found, so assignment.size() < tutorial_count marks the shortfall.
+ * Tutorials whose schedule has no slots get no rooms.
+ */
+void core_tutorial_allocation_logic(std::vector<Tutorial> &tutorials, VenueTable &venues, std::vector<uint32_t> &tutorial_building_priority_order, int convenience_factor, const SchedulePatternTable &schedule_patterns);
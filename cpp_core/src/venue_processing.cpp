@@ -1,21 +1,18 @@
 #include <string>
 #include <vector>
-#include <map>
 #include "../helpers/json.hpp"
 #include "ds.hpp"
+#include "venue_table.hpp"
 
-std::map<std::string, std::vector<Venue>> venue_processing(const std::vector<nlohmann::json> &j){
+VenueTable venue_processing(const std::vector<nlohmann::json> &j, NamePools &names){
     
-    std::map<std::string, std::vector<Venue>> venues;
+    std::vector<Venue> venues;
 
-    for(auto venue: j){
+    for(auto &venue: j){
         if(venue.contains("building") && venue.at("building").is_string()){
-            venues[venue.at("building").get<std::string>()].push_back(venue);
+            venues.push_back(Venue(venue, names));
         }
     }
 
-    for(auto building: venues){
-        std::sort(building.second.begin(), building.second.end(), Venue::compareByCapacity);
-    }
-    return venues;
+    return VenueTable(venues, names.buildings.size());
 }
\ No newline at end of file
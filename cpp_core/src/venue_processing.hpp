@@ -2,7 +2,7 @@
 
 #include <vector>
 #include <string>
-#include <map>
 #include "ds.hpp"
+#include "venue_table.hpp"
 
-std::map<std::string, std::vector<Venue>> venue_processing(const std::vector<nlohmann::json> &j);
\ No newline at end of file
+VenueTable venue_processing(const std::vector<nlohmann::json> &j, NamePools &names);
\ No newline at end of file
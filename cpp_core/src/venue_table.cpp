@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "venue_table.hpp"
+#include "sort_order.hpp"
+
+VenueTable::VenueTable(const std::vector<Venue> &venues, uint32_t building_count){
+    // Venue IDs follow (building, capacity); two stable counting passes order the indices only.
+    int venue_count = venues.size();
+    std::vector<int> order = counting_sort_order(venue_count, [&venues](int ind){ return venues[ind].capacity; });
+    counting_sort_indices(order, [&venues](int ind){ return (int)venues[ind].building; });
+
+    capacities.reserve(venue_count);
+    building_ids.reserve(venue_count);
+    opening_ids.reserve(venue_count);
+    booked.assign(venue_count, SlotMask());
+    hall_names.reserve(venue_count);
+    assignments.resize(venue_count);
+    building_ranges.resize(building_count);
+    std::unordered_map<SlotMask, int> template_ids;
+
+    for(int ind = 0; ind < venue_count; ind++){
+        const Venue &venue = venues[order[ind]];
+        if(ind == 0 || venues[order[ind - 1]].building != venue.building){
+            building_ranges[venue.building].begin = ind;
+        }
+        building_ranges[venue.building].end = ind + 1;
+
+        capacities.push_back(venue.capacity);
+        building_ids.push_back(venue.building);
+        auto found = template_ids.find(venue.is_available);
+        if(found == template_ids.end()){
+            found = template_ids.emplace(venue.is_available, (int)opening_templates.size()).first;
+            opening_templates.push_back(venue.is_available);
+        }
+        opening_ids.push_back(found->second);
+        hall_names.push_back(venue.hall_name);
+    }
+
+    for(auto &range: building_ranges){
+        capacity_indexes.emplace_back(capacities.begin() + range.begin, capacities.begin() + range.end);
+    }
+}
+
+std::vector<int> VenueTable::resolve_buildings(const std::vector<uint32_t> &buildings) const {
+    std::vector<int> ids;
+    for(auto building: buildings){
+        if(building >= building_ranges.size() || building_ranges[building].begin == building_ranges[building].end)continue;
+        if(std::find(ids.begin(), ids.end(), (int)building) == ids.end())ids.push_back(building);
+    }
+    return ids;
+}
\ No newline at end of file
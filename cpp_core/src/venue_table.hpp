@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "ds.hpp"
+#include "capacity_index.hpp"
+
+/**
+ * @class VenueTable
+ * @brief All halls of the campus as parallel arrays indexed by venue ID.
+ * Halls are grouped by building and sorted by ascending capacity inside a building, so each
+ * building is one contiguous range of venue IDs that is resolved once before allocation.
+ */
+class VenueTable {
+public:
+    struct BuildingRange {
+        int begin = 0;
+        int end = 0;
+    };
+
+    // A course section holding a hall for some slots.
+    struct Booking {
+        uint32_t course_code;
+        uint32_t section;
+        SlotMask slots;
+    };
+
+    // Per venue ID.
+    std::vector<int> capacities;
+    std::vector<uint32_t> building_ids;
+    std::vector<int> opening_ids;        // opening hours, index into opening_templates
+    std::vector<SlotMask> booked;        // slots already given to a course
+    std::vector<uint32_t> hall_names;   // IDs in NamePools::halls
+    std::vector<std::vector<Booking>> assignments;
+
+    // Per building ID (the building's ID in NamePools::buildings).
+    std::vector<BuildingRange> building_ranges;
+    std::vector<CapacityIndex> capacity_indexes; // built once, ranks match the building's range
+
+    // Distinct opening masks; halls with identical hours share one entry.
+    std::vector<SlotMask> opening_templates;
+
+    VenueTable() = default;
+
+    /**
+     * @brief Lays out parsed halls building by building, by ascending capacity.
+     * @param venues The halls in input order.
+     * @param building_count Number of interned building IDs.
+     * @throws std::invalid_argument if a building's capacity order does not hold after layout.
+     */
+    VenueTable(const std::vector<Venue> &venues, uint32_t building_count);
+
+    int size() const { return (int)capacities.size(); }
+
+    int building_count() const { return (int)building_ranges.size(); }
+
+    // The given building IDs in order, skipping IDs without halls (or StringPool::NO_ID) and repeats.
+    std::vector<int> resolve_buildings(const std::vector<uint32_t> &buildings) const;
+
+    // Slots in which a hall is open and not yet booked.
+    SlotMask availability(int venue) const {
+        SlotMask free_slots = opening_templates[opening_ids[venue]];
+        free_slots.remove(booked[venue]);
+        return free_slots;
+    }
+
+    bool is_free(int venue, const SlotMask &slots) const {
+        return opening_templates[opening_ids[venue]].contains(slots) && !booked[venue].intersects(slots);
+    }
+
+    // Books a hall for the slots of a course section.
+    void book(int venue, uint32_t course_code, uint32_t section, const SlotMask &slots){
+        booked[venue] |= slots;
+        assignments[venue].push_back({course_code, section, slots});
+    }
+
+    // Releases the booking a course section holds in a hall for exactly these slots.
+    void unbook(int venue, uint32_t course_code, uint32_t section, const SlotMask &slots){
+        std::vector<Booking> &bookings = assignments[venue];
+        for(size_t ind = 0; ind < bookings.size(); ind++){
+            if(bookings[ind].course_code != course_code || bookings[ind].section != section || bookings[ind].slots != slots)continue;
+            booked[venue].remove(bookings[ind].slots);
+            bookings.erase(bookings.begin() + ind);
+            return;
+        }
+    }
+};
@@ -0,0 +1,263 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "course_preprocessing.hpp"
+#include "course_processing.hpp"
+#include "venue_processing.hpp"
+#include "lecture_allocation.hpp"
+#include "exact_allocation.hpp"
+#include "pattern_matching.hpp"
+#include "component_allocation.hpp"
+#include "local_search.hpp"
+#include "ejection_repair.hpp"
+#include "convenience_tuning.hpp"
+#include "portfolio_allocation.hpp"
+#include "incremental_allocation.hpp"
+
+namespace {
+
+/**
+ * A crowded campus built from a fixed seed: priority buildings A and B, and a building C outside
+ * the priority list that no allocator may use. Some lectures are modular, and some are too large
+ * for any hall.
+ */
+struct Campus {
+    NamePools names;
+    SchedulePatternTable patterns;
+    VenueTable venues;
+    std::vector<Lecture> lectures;
+    std::vector<uint32_t> priority;
+
+    // `courses` lectures, enrolments divided by `divisor` and those of the first `doubled` doubled.
+    explicit Campus(int courses = 120, int divisor = 1, int doubled = 0){
+        std::mt19937 rng(2024);
+        auto pick = [&rng](int low, int high){ return std::uniform_int_distribution<int>(low, high)(rng); };
+
+        nlohmann::json weekdays;
+        nlohmann::json all_week;
+        for(int day = 0; day < DAYS_PER_WEEK; day++){
+            all_week[WEEK_DAYS[day].name] = nlohmann::json::array({{{"open", "00:00"}, {"close", "24:00"}}});
+            if(day < 5)weekdays[WEEK_DAYS[day].name] = nlohmann::json::array({{{"open", "08:00"}, {"close", "18:00"}}});
+        }
+        std::vector<nlohmann::json> halls;
+        for(const char *building: {"A", "B", "C"}){
+            for(int hall = 0; hall < 7; hall++){
+                halls.push_back({
+                    {"name", std::string(building) + std::to_string(hall)},
+                    {"building", building},
+                    {"capacity", 30 + 20 * pick(0, 6)},
+                    {"schedule", hall % 3 == 0 ? all_week : weekdays}
+                });
+            }
+        }
+        venues = venue_processing(halls, names);
+        priority = {names.buildings.find("A"), names.buildings.find("B")};
+
+        const char *days[] = {"MWF", "TTh", "M", "W", "F", "MW", "Sa"};
+        std::vector<nlohmann::json> course_data;
+        for(int course = 0; course < courses; course++){
+            int start = pick(8, 18);
+            int length = pick(1, 2);
+            char schedule[32];
+            std::snprintf(schedule, sizeof(schedule), "%s %02d:00-%02d:00", days[pick(0, 6)], start, start + length);
+            nlohmann::json entry = {
+                {"Course Code", "C" + std::to_string(course / 2)},
+                {"Section", std::to_string(course % 2 + 1)},
+                {"Lecture Schedule", schedule},
+                {"Students Registered", pick(15, 170)}
+            };
+            if(course % 5 == 0)entry["Modular Course"] = course % 2 + 1;
+            course_data.push_back(entry);
+        }
+        std::vector<Course> preprocessed = course_preprocessing_function(course_data, patterns, names);
+        lectures = course_processing(preprocessed).first;
+        for(int ind = 0; ind < (int)lectures.size(); ind++){
+            lectures[ind].students_registered = lectures[ind].students_registered / divisor * (ind < doubled ? 2 : 1);
+        }
+    }
+};
+
+// Checks an allocation against the campus it started from; returns the number of violations.
+int violations(const char *mode, const Campus &start, const Campus &campus){
+    int found = 0;
+    auto report = [&found, mode](const char *what, int lecture){
+        std::fprintf(stderr, "%s: lecture %d %s\n", mode, lecture, what);
+        found++;
+    };
+
+    const VenueTable &venues = campus.venues;
+    std::vector<SlotMask> held(venues.size());
+    std::vector<int> bookings(venues.size(), 0);
+    if(campus.lectures.size() != start.lectures.size())report("count changed", -1);
+    for(int ind = 0; ind < (int)campus.lectures.size() && ind < (int)start.lectures.size(); ind++){
+        const Lecture &lecture = campus.lectures[ind];
+        if(lecture.course_code != start.lectures[ind].course_code || lecture.lecture_pattern != start.lectures[ind].lecture_pattern){
+            report("moved in the list", ind);
+        }
+        int venue = lecture.assignment;
+        if(venue == -1)continue;
+        if(venue < 0 || venue >= venues.size()){
+            report("has no such hall", ind);
+            continue;
+        }
+        const SlotMask &slots = campus.patterns.slots(lecture.lecture_pattern);
+        if(venues.capacities[venue] < lecture.students_registered)report("exceeds the hall's capacity", ind);
+        if(venues.building_ids[venue] == campus.names.buildings.find("C"))report("is outside the priority buildings", ind);
+        if(!venues.opening_templates[venues.opening_ids[venue]].contains(slots))report("is outside opening hours", ind);
+        if(held[venue].intersects(slots))report("double-books its hall", ind);
+        held[venue] |= slots;
+        bookings[venue]++;
+    }
+    for(int venue = 0; venue < venues.size(); venue++){
+        if(!(venues.booked[venue] == held[venue]) || (int)venues.assignments[venue].size() != bookings[venue]){
+            std::fprintf(stderr, "%s: bookings of hall %d do not match its lectures\n", mode, venue);
+            found++;
+        }
+    }
+    return found;
+}
+
+int unassigned(const Campus &campus){
+    int count = 0;
+    for(auto &lecture: campus.lectures)count += lecture.assignment == -1;
+    return count;
+}
+
+void greedy_modes(){
+    const Campus start;
+    Campus greedy;
+    core_lecture_allocation_logic(greedy.lectures, greedy.venues, greedy.priority, 10, greedy.patterns);
+    CHECK(violations("greedy", start, greedy) == 0);
+    CHECK(unassigned(greedy) > 0 && unassigned(greedy) < (int)greedy.lectures.size());
+
+    Campus merged;
+    merged_lecture_allocation_logic(merged.lectures, merged.venues, merged.priority, 10, merged.patterns);
+    CHECK(violations("merged", start, merged) == 0);
+
+    Campus dynamic;
+    dynamic_lecture_allocation_logic(dynamic.lectures, dynamic.venues, dynamic.priority, 10, dynamic.patterns);
+    CHECK(violations("dynamic", start, dynamic) == 0);
+}
+
+void exact_and_matching(){
+    const Campus start;
+    Campus exact;
+    ExactAllocationLimits limits;
+    limits.node_limit = 200000;
+    limits.time_limit_ms = 1000;
+    ExactAllocationResult result = exact_lecture_allocation(exact.lectures, exact.venues, exact.priority, exact.patterns, limits);
+    CHECK(violations("exact", start, exact) == 0);
+    CHECK(result.unassigned == unassigned(exact));
+
+    Campus greedy;
+    core_lecture_allocation_logic(greedy.lectures, greedy.venues, greedy.priority, 0, greedy.patterns);
+    CHECK(unassigned(exact) <= unassigned(greedy));
+
+    Campus matching;
+    pattern_matching_allocation(matching.lectures, matching.venues, matching.priority, matching.patterns);
+    CHECK(violations("matching", start, matching) == 0);
+}
+
+void split_components(){
+    const Campus start;
+    Campus greedy;
+    ComponentSolver solve_greedy = [&greedy](std::vector<Lecture> &lectures, VenueTable &venues){
+        core_lecture_allocation_logic(lectures, venues, greedy.priority, 10, greedy.patterns);
+    };
+    ComponentAllocationResult result = component_allocation(greedy.lectures, greedy.venues, greedy.patterns, solve_greedy, 3);
+    CHECK(violations("split greedy", start, greedy) == 0);
+    CHECK(result.components > 1);
+
+    Campus exact;
+    ExactAllocationLimits limits;
+    limits.node_limit = 20000;
+    ComponentSolver solve_exact = [&exact, &limits](std::vector<Lecture> &lectures, VenueTable &venues){
+        exact_lecture_allocation(lectures, venues, exact.priority, exact.patterns, limits);
+    };
+    component_allocation(exact.lectures, exact.venues, exact.patterns, solve_exact, 2);
+    CHECK(violations("split exact", start, exact) == 0);
+}
+
+void improvers(){
+    const Campus start;
+    Campus annealed;
+    core_lecture_allocation_logic(annealed.lectures, annealed.venues, annealed.priority, 10, annealed.patterns);
+    LocalSearchOptions options;
+    options.iterations = 20000;
+    options.chains = 2;
+    options.seed = 7;
+    LocalSearchResult search = improve_lecture_allocation(annealed.lectures, annealed.venues, annealed.priority, annealed.patterns, options);
+    CHECK(violations("local search", start, annealed) == 0);
+    CHECK(search.after.unassigned <= search.before.unassigned);
+
+    Campus repaired;
+    core_lecture_allocation_logic(repaired.lectures, repaired.venues, repaired.priority, 10, repaired.patterns);
+    RepairResult repair = repair_unassigned_lectures(repaired.lectures, repaired.venues, repaired.priority, repaired.patterns, RepairOptions());
+    CHECK(violations("repair", start, repaired) == 0);
+    CHECK(unassigned(repaired) == repair.unassigned_before - repair.repaired);
+}
+
+void portfolio_and_tuning(){
+    const Campus start;
+    Campus portfolio;
+    PortfolioOptions options;
+    options.time_budget_ms = 300;
+    options.threads = 2;
+    PortfolioResult result = portfolio_lecture_allocation(portfolio.lectures, portfolio.venues, portfolio.priority, 10, portfolio.patterns, options);
+    CHECK(violations("portfolio", start, portfolio) == 0);
+    CHECK(result.winner >= 0 && result.runs[result.winner].stats.unassigned == unassigned(portfolio));
+
+    // On the crowded campus the tuning fails and leaves the lectures as they were.
+    Campus crowded;
+    ConvenienceTuningResult crowded_tuning = tune_convenience_factor(crowded.lectures, crowded.venues, crowded.priority, 0, 60, crowded.patterns);
+    CHECK(!crowded_tuning.feasible);
+    CHECK(violations("autotune, infeasible", start, crowded) == 0);
+    CHECK(unassigned(crowded) == (int)crowded.lectures.size());
+
+    // A smaller campus with a quarter of the students fits, and the tuned assignment keeps the headroom.
+    const Campus small_start(30, 4);
+    Campus small(30, 4);
+    ConvenienceTuningResult tuning = tune_convenience_factor(small.lectures, small.venues, small.priority, 0, 60, small.patterns);
+    CHECK(violations("autotune", small_start, small) == 0);
+    CHECK(tuning.feasible);
+    if(tuning.feasible){
+        CHECK(unassigned(small) == 0);
+        for(auto &lecture: small.lectures){
+            CHECK(small.venues.capacities[lecture.assignment] * 100 >= lecture.students_registered * (100 + tuning.convenience_factor));
+        }
+    }
+}
+
+// A re-run after some enrolments doubled keeps the rest of the earlier greedy schedule.
+void incremental(){
+    Campus before;
+    core_lecture_allocation_logic(before.lectures, before.venues, before.priority, 10, before.patterns);
+
+    const Campus start(120, 1, 10);
+    Campus after(120, 1, 10);
+    // Both campuses intern the same names in the same order, so their IDs agree.
+    std::vector<PreviousAssignment> previous;
+    for(auto &lecture: before.lectures){
+        if(lecture.assignment == -1)continue;
+        previous.push_back({lecture.course_code, lecture.section, lecture.term_part, lecture.lecture_pattern,
+            before.venues.building_ids[lecture.assignment], before.venues.hall_names[lecture.assignment]});
+    }
+    IncrementalResult result = incremental_lecture_allocation(after.lectures, after.venues, after.priority, 10, previous, after.patterns);
+    CHECK(violations("incremental", start, after) == 0);
+    CHECK(result.kept >= (int)previous.size() - 10);
+    CHECK(result.kept + result.affected == (int)after.lectures.size());
+}
+
+}
+
+int main(){
+    greedy_modes();
+    exact_and_matching();
+    split_components();
+    improvers();
+    portfolio_and_tuning();
+    incremental();
+    return check_result();
+}
@@ -0,0 +1,54 @@
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "check.hpp"
+#include "capacity_index.hpp"
+
+namespace {
+
+// Every lookup must agree with std::lower_bound over the same capacities.
+void matches_lower_bound(const std::vector<int> &capacities){
+    CapacityIndex index(capacities.begin(), capacities.end());
+    CHECK(index.size() == (int)capacities.size());
+    int largest = capacities.empty() ? 0 : capacities.back();
+    for(int seats = -5; seats <= largest + 2 * CapacityIndex::BUCKET_SEATS; seats++){
+        int expected = std::lower_bound(capacities.begin(), capacities.end(), seats) - capacities.begin();
+        if(seats <= 0)expected = 0;
+        CHECK(index.lower_bound_rank(seats) == expected);
+    }
+}
+
+void lookups(){
+    matches_lower_bound({});
+    matches_lower_bound({30});
+    matches_lower_bound({10, 20, 30, 40});
+    matches_lower_bound({25, 25, 25, 60, 60, 61, 99, 100, 101, 250});
+    matches_lower_bound({0, 0, 9, 10, 11, 19, 20});
+
+    std::vector<int> same(50, 40);
+    matches_lower_bound(same);
+
+    CapacityIndex index(same.begin(), same.end());
+    CHECK(index.lower_bound_rank(41) == index.size());
+    CHECK(index.capacity_at(0) == 40);
+}
+
+void rejects_unsorted(){
+    std::vector<int> capacities = {30, 10, 20};
+    bool threw = false;
+    try{
+        CapacityIndex index(capacities.begin(), capacities.end());
+    }
+    catch(const std::invalid_argument &){
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+}
+
+int main(){
+    lookups();
+    rejects_unsorted();
+    return check_result();
+}
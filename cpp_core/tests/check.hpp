@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdio>
+
+/**
+ * @brief Minimal checks for the engine tests. A failed CHECK reports its line and the run carries
+ * on; main returns check_result(), which is non-zero once any check failed.
+ */
+inline int &check_failures(){
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition) \
+    do{ \
+        if(!(condition)){ \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            check_failures()++; \
+        } \
+    }while(0)
+
+inline int check_result(){
+    if(check_failures())std::fprintf(stderr, "%d check(s) failed\n", check_failures());
+    return check_failures() ? 1 : 0;
+}
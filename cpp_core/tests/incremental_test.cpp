@@ -0,0 +1,117 @@
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "incremental_allocation.hpp"
+#include "venue_processing.hpp"
+
+namespace {
+
+// One building "B" with halls Y (80 seats) and Z (100 seats), open all week.
+struct Campus {
+    NamePools names;
+    SchedulePatternTable patterns;
+    VenueTable venues;
+    std::vector<uint32_t> priority;
+
+    Campus(){
+        nlohmann::json open_all_day = nlohmann::json::array({{{"open", "00:00"}, {"close", "24:00"}}});
+        nlohmann::json schedule;
+        for(auto &day: WEEK_DAYS)schedule[day.name] = open_all_day;
+
+        std::vector<nlohmann::json> halls = {
+            {{"name", "Y"}, {"building", "B"}, {"capacity", 80}, {"schedule", schedule}},
+            {{"name", "Z"}, {"building", "B"}, {"capacity", 100}, {"schedule", schedule}}
+        };
+        venues = venue_processing(halls, names);
+        priority = {names.buildings.find("B")};
+    }
+
+    Lecture lecture(const char *code, const char *schedule, int students, TermPart part = TermPart::Full){
+        return Lecture(0, names.course_codes.intern(code), 0, patterns.intern(schedule, part), students, part);
+    }
+
+    PreviousAssignment in(const char *code, const char *hall, TermPart part = TermPart::Full, int pattern = -1){
+        return {names.course_codes.find(code), 0, part, pattern, names.buildings.find("B"), names.halls.find(hall)};
+    }
+
+    std::string hall_of(const Lecture &lecture) const {
+        return lecture.assignment == -1 ? "" : names.halls.text(venues.hall_names[lecture.assignment]);
+    }
+};
+
+// Two lectures of one course, both previously in Z, keep Z although the greedy would pick Y.
+void repeated_code_keeps_both(){
+    Campus campus;
+    std::vector<Lecture> lectures = {
+        campus.lecture("X", "M 09:00-10:00", 60),
+        campus.lecture("X", "T 09:00-10:00", 60)
+    };
+    std::vector<PreviousAssignment> previous = {campus.in("X", "Z"), campus.in("X", "Z")};
+
+    IncrementalResult result = incremental_lecture_allocation(lectures, campus.venues, campus.priority, 0, previous, campus.patterns);
+    CHECK(result.kept == 2);
+    CHECK(result.affected == 0);
+    CHECK(result.shared_keys == 2);
+    CHECK(campus.hall_of(lectures[0]) == "Z");
+    CHECK(campus.hall_of(lectures[1]) == "Z");
+}
+
+// Lines that give their schedule go to the lecture with that schedule, whatever their order.
+void schedule_picks_the_lecture(){
+    Campus campus;
+    std::vector<Lecture> lectures = {
+        campus.lecture("X", "M 09:00-10:00", 60),
+        campus.lecture("X", "T 09:00-10:00", 60)
+    };
+    std::vector<PreviousAssignment> previous = {
+        campus.in("X", "Z", TermPart::Full, campus.patterns.find("T 09:00-10:00")),
+        campus.in("X", "Y", TermPart::Full, campus.patterns.find("M 09:00-10:00"))
+    };
+
+    IncrementalResult result = incremental_lecture_allocation(lectures, campus.venues, campus.priority, 0, previous, campus.patterns);
+    CHECK(result.kept == 2);
+    CHECK(campus.hall_of(lectures[0]) == "Y");
+    CHECK(campus.hall_of(lectures[1]) == "Z");
+}
+
+// The two halves of a modular course have their own key and can both keep the same hall and slot.
+void term_part_is_part_of_the_key(){
+    Campus campus;
+    std::vector<Lecture> lectures = {
+        campus.lecture("X", "M 09:00-10:00", 60, TermPart::FirstHalf),
+        campus.lecture("X", "M 09:00-10:00", 60, TermPart::SecondHalf)
+    };
+    std::vector<PreviousAssignment> previous = {
+        campus.in("X", "Z", TermPart::SecondHalf),
+        campus.in("X", "Z", TermPart::FirstHalf)
+    };
+
+    IncrementalResult result = incremental_lecture_allocation(lectures, campus.venues, campus.priority, 0, previous, campus.patterns);
+    CHECK(result.kept == 2);
+    CHECK(result.shared_keys == 0);
+    CHECK(campus.hall_of(lectures[0]) == "Z");
+    CHECK(campus.hall_of(lectures[1]) == "Z");
+}
+
+// A line that no longer fits its lecture is dropped and the lecture is placed again.
+void lines_that_no_longer_fit(){
+    Campus campus;
+    std::vector<Lecture> lectures = {campus.lecture("X", "M 09:00-10:00", 90)};
+    std::vector<PreviousAssignment> previous = {campus.in("X", "Y"), campus.in("W", "Z")};
+
+    IncrementalResult result = incremental_lecture_allocation(lectures, campus.venues, campus.priority, 0, previous, campus.patterns);
+    CHECK(result.kept == 0);
+    CHECK(result.affected == 1);
+    CHECK(result.placed == 1);
+    CHECK(campus.hall_of(lectures[0]) == "Z");
+}
+
+}
+
+int main(){
+    repeated_code_keeps_both();
+    schedule_picks_the_lecture();
+    term_part_is_part_of_the_key();
+    lines_that_no_longer_fit();
+    return check_result();
+}
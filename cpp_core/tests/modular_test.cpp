@@ -0,0 +1,84 @@
+#include <vector>
+#include "check.hpp"
+#include "course_preprocessing.hpp"
+#include "course_processing.hpp"
+#include "venue_processing.hpp"
+#include "lecture_allocation.hpp"
+
+namespace {
+
+void term_part_field(){
+    CHECK(course_term_part({{"Modular Course", 1}}) == TermPart::FirstHalf);
+    CHECK(course_term_part({{"Modular Course", "2"}}) == TermPart::SecondHalf);
+    CHECK(course_term_part({{"Modular Course", 3}}) == TermPart::Full);
+    CHECK(course_term_part({{"Modular Course", "yes"}}) == TermPart::Full);
+    CHECK(course_term_part(nlohmann::json::object()) == TermPart::Full);
+}
+
+// Lectures of the given courses, allocated by the greedy into a single hall "H" open all week.
+struct OneHall {
+    NamePools names;
+    SchedulePatternTable patterns;
+    VenueTable venues;
+    std::vector<Lecture> lectures;
+
+    explicit OneHall(const std::vector<nlohmann::json> &courses){
+        nlohmann::json open_all_day = nlohmann::json::array({{{"open", "00:00"}, {"close", "24:00"}}});
+        nlohmann::json schedule;
+        for(auto &day: WEEK_DAYS)schedule[day.name] = open_all_day;
+        venues = venue_processing({{{"name", "H"}, {"building", "B"}, {"capacity", 100}, {"schedule", schedule}}}, names);
+
+        std::vector<Course> preprocessed = course_preprocessing_function(courses, patterns, names);
+        lectures = course_processing(preprocessed).first;
+        std::vector<uint32_t> priority = {names.buildings.find("B")};
+        core_lecture_allocation_logic(lectures, venues, priority, 0, patterns);
+    }
+};
+
+// The two halves of the term share a weekly slot without overlapping.
+void halves_share_a_hall(){
+    OneHall campus({
+        {{"Course Code", "A"}, {"Lecture Schedule", "M 09:00-10:00"}, {"Students Registered", 50}, {"Modular Course", 1}},
+        {{"Course Code", "B"}, {"Lecture Schedule", "M 09:00-10:00"}, {"Students Registered", 50}, {"Modular Course", 2}}
+    });
+    const Lecture &first = campus.lectures[0];
+    const Lecture &second = campus.lectures[1];
+    CHECK(first.is_modular() && second.is_modular());
+    CHECK(first.lecture_pattern != second.lecture_pattern);
+    CHECK(!campus.patterns.slots(first.lecture_pattern).intersects(campus.patterns.slots(second.lecture_pattern)));
+    CHECK(first.assignment == 0);
+    CHECK(second.assignment == 0);
+    CHECK(campus.venues.assignments[0].size() == 2);
+}
+
+// A full-term course overlaps both halves: the hall goes either to it or to the two halves.
+void full_term_blocks_both_halves(){
+    OneHall campus({
+        {{"Course Code", "F"}, {"Lecture Schedule", "M 09:00-10:00"}, {"Students Registered", 60}},
+        {{"Course Code", "A"}, {"Lecture Schedule", "M 09:00-10:00"}, {"Students Registered", 50}, {"Modular Course", 1}},
+        {{"Course Code", "B"}, {"Lecture Schedule", "M 09:30-10:30"}, {"Students Registered", 50}, {"Modular Course", 2}}
+    });
+    bool full_placed = campus.lectures[0].assignment == 0;
+    CHECK(full_placed != (campus.lectures[1].assignment == 0));
+    CHECK(full_placed != (campus.lectures[2].assignment == 0));
+}
+
+// Halves in the same half of the term still collide.
+void same_half_collides(){
+    OneHall campus({
+        {{"Course Code", "A"}, {"Lecture Schedule", "M 09:00-10:00"}, {"Students Registered", 60}, {"Modular Course", 2}},
+        {{"Course Code", "B"}, {"Lecture Schedule", "M 09:30-10:30"}, {"Students Registered", 50}, {"Modular Course", 2}}
+    });
+    CHECK((campus.lectures[0].assignment == 0) != (campus.lectures[1].assignment == 0));
+    CHECK(campus.venues.assignments[0].size() == 1);
+}
+
+}
+
+int main(){
+    term_part_field();
+    halves_share_a_hall();
+    full_term_blocks_both_halves();
+    same_half_collides();
+    return check_result();
+}
@@ -0,0 +1,126 @@
+#include <string>
+#include "check.hpp"
+#include "helper.hpp"
+#include "schedule_pattern.hpp"
+
+namespace {
+
+ScheduleParseError parse(const char *schedule, SlotMask &slots){
+    slots = SlotMask();
+    return parse_schedule(schedule, slots);
+}
+
+void well_formed(){
+    SlotMask slots;
+    CHECK(parse("MWF 09:00-10:00, Th 14:00-15:15", slots) == ScheduleParseError::None);
+
+    SlotMask expected;
+    for(int day: {0, 2, 4}){
+        expected.set_range(TimeGrid::slot_of(day, 9 * 60), TimeGrid::slot_of(day, 10 * 60));
+    }
+    // An end inside a slot takes that slot whole.
+    expected.set_range(TimeGrid::slot_of(3, 14 * 60), 3 * SLOTS_PER_DAY + TimeGrid::slot_ceil(15 * 60 + 15));
+    CHECK(slots == expected);
+
+    CHECK(parse("T 9:30-11:00", slots) == ScheduleParseError::None);
+    CHECK(slots.test(TimeGrid::slot_of(1, 9 * 60 + 30)));
+    CHECK(!slots.test(TimeGrid::slot_of(1, 9 * 60)));
+}
+
+void rejects_negative_times(){
+    SlotMask slots;
+    CHECK(parse("M -1:00-10:00", slots) == ScheduleParseError::BadTime);
+    CHECK(slots.none());
+    CHECK(parse("M 9:-5-10:00", slots) == ScheduleParseError::BadTime);
+    CHECK(slots.none());
+    CHECK(parse("M 09:00--10:00", slots) == ScheduleParseError::BadTime);
+    CHECK(parse("M +9:00-10:00", slots) == ScheduleParseError::BadTime);
+}
+
+void rejects_malformed(){
+    SlotMask slots;
+    CHECK(parse("MWF 9am-10am", slots) == ScheduleParseError::BadTime);
+    CHECK(parse("M 9:00", slots) == ScheduleParseError::BadTime);
+    CHECK(parse("M 9:60-10:00", slots) == ScheduleParseError::BadTime);
+    CHECK(parse("M 23:00-24:30", slots) == ScheduleParseError::BadTime);
+    CHECK(parse("M 123:00-124:00", slots) == ScheduleParseError::BadTime);
+    CHECK(parse("09:00-10:00", slots) == ScheduleParseError::MissingDays);
+    CHECK(parse("M 10:00-09:00", slots) == ScheduleParseError::EmptyRange);
+    CHECK(parse("M 10:00-10:00", slots) == ScheduleParseError::EmptyRange);
+}
+
+void slot_buffer(){
+    // Room for one hour of slots, whatever the slot width.
+    constexpr int HOUR_SLOTS = 60 / SLOT_MINUTES;
+    int buffer[HOUR_SLOTS];
+    int count = 0;
+    CHECK(parse_schedule("M 09:00-10:00", buffer, HOUR_SLOTS, count) == ScheduleParseError::None);
+    CHECK(count == HOUR_SLOTS);
+    CHECK(buffer[0] == TimeGrid::slot_of(0, 9 * 60));
+    CHECK(buffer[HOUR_SLOTS - 1] == TimeGrid::slot_of(0, 10 * 60) - 1);
+
+    CHECK(parse_schedule("MTWThF 09:00-13:00", buffer, HOUR_SLOTS, count) == ScheduleParseError::BufferFull);
+    CHECK(count <= HOUR_SLOTS);
+}
+
+void fixed_clock(){
+    int minutes = 0;
+    CHECK(parse_fixed_clock("08:15", minutes) && minutes == 8 * 60 + 15);
+    CHECK(parse_fixed_clock("24:00", minutes) && minutes == 24 * 60);
+    CHECK(!parse_fixed_clock("8:15", minutes));
+    CHECK(!parse_fixed_clock("-1:00", minutes));
+    CHECK(!parse_fixed_clock("24:01", minutes));
+}
+
+// Days of a schedule, as a bitmask over day indices.
+unsigned days_of(const SlotMask &slots){
+    unsigned days = 0;
+    slots.for_each_slot([&days](int slot){ days |= 1u << (slot / SLOTS_PER_DAY); });
+    return days;
+}
+
+void day_codes(){
+    CHECK(DAYS_PER_WEEK == 7);
+    CHECK(WEEK_SLOTS == 7 * SLOTS_PER_DAY);
+
+    SlotMask slots;
+    CHECK(parse("TTh 10:30-12:00", slots) == ScheduleParseError::None);
+    CHECK(days_of(slots) == ((1u << 1) | (1u << 3)));
+    CHECK(parse("SaSu 10:00-11:00", slots) == ScheduleParseError::None);
+    CHECK(days_of(slots) == ((1u << 5) | (1u << 6)));
+    CHECK(slots.test(TimeGrid::slot_of(6, 10 * 60)));
+    CHECK(parse("MThSa 08:00-09:00", slots) == ScheduleParseError::None);
+    CHECK(days_of(slots) == ((1u << 0) | (1u << 3) | (1u << 5)));
+    CHECK(parse("F 23:00-24:00", slots) == ScheduleParseError::None);
+    CHECK(slots.test(TimeGrid::slot_of(4, 23 * 60 + 30)) && !slots.test(TimeGrid::slot_of(5, 0)));
+
+    CHECK(parse("Tu 10:00-11:00", slots) == ScheduleParseError::UnknownDay);
+    CHECK(parse("MX 10:00-11:00", slots) == ScheduleParseError::UnknownDay);
+    CHECK(parse("m 10:00-11:00", slots) == ScheduleParseError::UnknownDay);
+    CHECK(parse("M 09:00-10:00, 11:00-12:00", slots) == ScheduleParseError::MissingDays);
+}
+
+void pattern_table_keeps_errors(){
+    SchedulePatternTable patterns;
+    int good = patterns.intern("MWF 09:00-10:00");
+    int bad = patterns.intern("MWF 9am-10am");
+    CHECK(patterns.error(good) == ScheduleParseError::None);
+    CHECK(patterns.error(bad) == ScheduleParseError::BadTime);
+    CHECK(patterns.slots(bad).none());
+    CHECK(patterns.intern("MWF 9am-10am", TermPart::FirstHalf) != bad);
+    CHECK(patterns.error(patterns.intern("MWF 9am-10am", TermPart::FirstHalf)) == ScheduleParseError::BadTime);
+    CHECK(std::string(schedule_parse_error_name(patterns.error(bad))) == "badTime");
+}
+
+}
+
+int main(){
+    well_formed();
+    rejects_negative_times();
+    rejects_malformed();
+    slot_buffer();
+    fixed_clock();
+    day_codes();
+    pattern_table_keeps_errors();
+    return check_result();
+}
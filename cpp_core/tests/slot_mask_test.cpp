@@ -0,0 +1,81 @@
+#include <vector>
+#include "check.hpp"
+#include "slot_mask.hpp"
+
+namespace {
+
+void set_range_crosses_words(){
+    SlotMask mask;
+    mask.set_range(60, 130);
+    CHECK(mask.count() == 70);
+    CHECK(!mask.test(59));
+    CHECK(mask.test(60));
+    CHECK(mask.test(64));
+    CHECK(mask.test(129));
+    CHECK(!mask.test(130));
+
+    SlotMask whole_word;
+    whole_word.set_range(64, 128);
+    CHECK(whole_word.bits[1] == ~uint64_t(0));
+    CHECK(whole_word.count() == 64);
+
+    SlotMask empty;
+    empty.set_range(10, 10);
+    CHECK(empty.none());
+}
+
+void set_operations(){
+    SlotMask morning;
+    morning.set_range(18, 24);
+    SlotMask late_morning;
+    late_morning.set_range(22, 26);
+    SlotMask evening;
+    evening.set_range(34, 36);
+
+    CHECK(morning.intersects(late_morning));
+    CHECK(!morning.intersects(evening));
+
+    SlotMask both = morning;
+    both |= evening;
+    CHECK(both.contains(morning));
+    CHECK(both.contains(evening));
+    CHECK(!both.contains(late_morning));
+
+    both.remove(morning);
+    CHECK(both == evening);
+
+    SlotMask overlap = morning;
+    overlap &= late_morning;
+    CHECK(overlap.count() == 2);
+    CHECK(overlap.test(22) && overlap.test(23));
+
+    std::vector<int> slots;
+    overlap.for_each_slot([&slots](int slot){ slots.push_back(slot); });
+    CHECK((slots == std::vector<int>{22, 23}));
+}
+
+void term_halves(){
+    SlotMask week;
+    week.set(5);
+    week.set(WEEK_SLOTS - 1);
+
+    SlotMask full = in_term(week, TermPart::Full);
+    SlotMask first = in_term(week, TermPart::FirstHalf);
+    SlotMask second = in_term(week, TermPart::SecondHalf);
+
+    CHECK(full.count() == 4);
+    CHECK(first.test(5) && !first.test(WEEK_SLOTS + 5));
+    CHECK(second.test(WEEK_SLOTS + 5) && !second.test(5));
+    CHECK(second.test(TERM_SLOTS - 1));
+    CHECK(!first.intersects(second));
+    CHECK(full.contains(first) && full.contains(second));
+}
+
+}
+
+int main(){
+    set_range_crosses_words();
+    set_operations();
+    term_halves();
+    return check_result();
+}